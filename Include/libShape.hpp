@@ -57,7 +57,27 @@ namespace libShape {
 
 };
 
+// The component headers include this header ahead of their own
+// include guards, so this list is always complete before any
+// component body is compiled, whichever header is included first
+#include <libShapeMapped.hpp>
 #include <libShapeDB.hpp>
+#include <libShapeKey.hpp>
 #include <libShapeFile.hpp>
+#include <libShapeIndex.hpp>
+#include <libShapeFlat.hpp>
+#include <libShapeArena.hpp>
+#include <libShapeSpatial.hpp>
+#include <libShapePrepared.hpp>
+#include <libShapeCache.hpp>
+#include <libShapeSimd.hpp>
+#include <libShapeSimplify.hpp>
+#include <libShapeSource.hpp>
+#include <libShapeStream.hpp>
+#include <libShapeLayer.hpp>
+#include <libShapeThreads.hpp>
+#include <libShapeView.hpp>
+#include <libShapeWriter.hpp>
+#include <libShapeZip.hpp>
 
 #endif /* libShape_h */
@@ -0,0 +1,118 @@
+//
+//  libShapeArena.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Arena allocation for decoded shapes.  Shapes built in an
+// arena, along with their coordinates, are carved out of a few
+// large blocks, and are all released together with the arena.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFlat.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEARENA_HPP
+#define	INCLUDE_LIBSHAPEARENA_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// A bump allocator handing out memory from large blocks
+	//
+	// Allocations are never freed one at a time - every block is
+	// released together when the arena is reset or destroyed.  Only
+	// objects that own no other resources may be placed in an arena.
+	// An arena is not thread safe.
+	class ShapeArena {
+
+	public:
+
+		// The default size of each block
+		const static size_t DEFAULT_BLOCK_SIZE;
+
+		// Construction
+		ShapeArena( const size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+		// Destruction - releases every block
+		virtual ~ShapeArena();
+
+		// Allocate memory - never returns NULL
+		void * allocate( const size_t numBytes, const size_t alignment = sizeof(double));
+
+		// Release every block at once
+		void reset();
+
+		// Get the number of bytes handed out
+		size_t getBytesUsed() const { return( bytesUsed); }
+
+		// Get the number of bytes held in blocks
+		size_t getBytesReserved() const { return( bytesReserved); }
+
+	protected:
+
+		// The size of each block
+		size_t nBlockSize;
+
+		// The blocks
+		std::vector<BYTE *> blocks;
+
+		// The next free byte of the current block
+		BYTE *pNext;
+
+		// The number of free bytes in the current block
+		size_t bytesFree;
+
+		// The running totals
+		size_t bytesUsed;
+		size_t bytesReserved;
+
+	private:
+
+		// Arenas may not be copied
+		ShapeArena( const ShapeArena &copyArena);
+		ShapeArena & operator=( const ShapeArena &copyArena);
+
+	};
+
+	// Factory function - build a shape, and its coordinates, inside an arena
+	// The shape is a FlatShape owned by the arena and must not be deleted
+	AbstractShape * buildArenaShape( ShapeArena &arena, const int recordNum, const BYTE *pBuffer, const size_t bufSize);
+
+};
+
+#endif
@@ -0,0 +1,159 @@
+//
+//  libShapeCache.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A decoded layer, with its spatial index and attribute columns, saved
+// in a file that is memory mapped and used in place.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeDB.hpp>
+#include <libShapeFlat.hpp>
+#include <libShapeMapped.hpp>
+#include <libShapeSpatial.hpp>
+
+#ifndef	INCLUDE_LIBSHAPECACHE_HPP
+#define	INCLUDE_LIBSHAPECACHE_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <cstdint>
+#include <string>
+
+namespace libShape {
+
+	// The layout of a cache file - defined with the cache
+	struct s_cache_header;
+	typedef struct s_cache_header S_CACHE_HEADER;
+	struct s_cache_column;
+	typedef struct s_cache_column S_CACHE_COLUMN;
+
+	// A decoded layer saved for memory mapping
+	//
+	// A cache file holds a flat layer, and optionally the nodes of an
+	// R-tree over it and decoded attribute columns, as arrays at offsets
+	// from the start of the file.  Nothing in the file is a pointer, so
+	// a read-only mapping is used as it stands - opening a cache touches
+	// only its header, and processes mapping the same file share its
+	// pages.  The arrays are in native byte order; caches written by a
+	// machine of another byte order or word size are never used.
+	//
+	// Each cache records the size and modification time of the shape
+	// file (and DB file, with columns) it was written from, and is only
+	// used while they are unchanged.
+	class LayerCache {
+
+	public:
+
+		// Construction - map the named cache file, if it is current for the source files
+		// The DB file must be given when the cache holds columns
+		LayerCache( const char *strCacheFile, const char *strShapeFile, const char *strDBFile = (const char *) 0x0);
+
+		// Destruction
+		virtual ~LayerCache();
+
+		// Is the cache usable? False if it is missing, out of date or damaged
+		bool isValid() const { return( (FlatLayer *) 0x0 != pLayer); }
+
+		// Get the layer - only for usable caches
+		const FlatLayer & getLayer() const;
+
+		// Get the R-tree over the layer, if one was saved
+		const ShapeRTree * getTree() const { return( pTree); }
+
+		// Get the number of attribute columns, and of records in each
+		size_t getColumnCount() const { return( numColumns); }
+		size_t getRecordCount() const { return( numRecords); }
+
+		// Find the column of a DB field - the column, or -1 if the field was not saved
+		long findColumn( const size_t nField) const;
+
+		// Get the field and decoded type of a column
+		size_t getColumnField( const size_t nColumn) const;
+		dbColumn::E_COLUMN_TYPE getColumnType( const size_t nColumn) const;
+
+		// Get the values of a column - NULL unless the column was decoded as that type
+		const double * getDoubles( const size_t nColumn) const;
+		const std::int64_t * getInt64s( const size_t nColumn) const;
+		const BYTE * getBools( const size_t nColumn) const;
+
+		// Get a value of a string column (not NUL terminated)
+		const char * getText( const size_t nColumn, const size_t nRecord, size_t &length) const;
+		std::string getString( const size_t nColumn, const size_t nRecord) const;
+
+		// Write a cache file
+		// The sources are stamped as they are when written, so write straight after decoding them.
+		// The tree must be over the layer, and every column must hold the same number of values.
+		// The file is written beside its final name and renamed into place, so processes opening
+		// it concurrently see either the old or the new cache.
+		static void write( const char *strCacheFile, const char *strShapeFile, const FlatLayer &layer,
+			const ShapeRTree *pRTree = (const ShapeRTree *) 0x0,
+			const char *strDBFile = (const char *) 0x0, const CNT_COLUMNS *pColumns = (const CNT_COLUMNS *) 0x0);
+
+	protected:
+
+		// Check the mapped file and attach to its arrays - false if it cannot be used
+		bool attach( const char *strShapeFile, const char *strDBFile);
+
+		// Get a column, failing if there is no such column
+		const S_CACHE_COLUMN & getColumn( const size_t nColumn) const;
+
+		// The mapping
+		MappedFile *pMapped;
+
+		// The header of the mapped file
+		const S_CACHE_HEADER *pHeader;
+
+		// The layer and tree over the mapped arrays
+		FlatLayer *pLayer;
+		ShapeRTree *pTree;
+
+		// The columns
+		const S_CACHE_COLUMN *pColumns;
+		size_t numColumns;
+		size_t numRecords;
+
+	private:
+
+		// Caches may not be copied
+		LayerCache( const LayerCache &copyCache);
+		LayerCache & operator=( const LayerCache &copyCache);
+
+	};
+
+};
+
+#endif
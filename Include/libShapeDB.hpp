@@ -32,17 +32,20 @@
 
 ***/
 
+// Project includes
+#include <libShape.hpp>
+#include <libShapeMapped.hpp>
+#include <libShapeSource.hpp>
+
 #ifndef	INCLUDE_LIBSHAPEDB_HPP
 #define	INCLUDE_LIBSHAPEDB_HPP
 
 // STL includes
+#include <cstdint>
 #include <list>
 #include <string>
 #include <vector>
 
-// Project includes
-#include <libShape.hpp>
-
 namespace libShape {
 
 	// A DB exception
@@ -71,6 +74,9 @@ namespace libShape {
 		// Construction from byte buffer
 		dbField( const BYTE *pBuffer, const size_t bufSize);
 
+		// Construction - describe a field to write (names hold at most 10 characters, lengths 1 to 254)
+		dbField( const char *strName, const E_FIELD_TYPE eType, const size_t length, const size_t decimals = 0);
+
 		// Destruction
 		virtual ~dbField();
 
@@ -105,13 +111,161 @@ namespace libShape {
 	typedef CNT_FIELDS::const_iterator CITR_FIELDS;
 	typedef CNT_FIELDS::iterator ITR_FIELDS;
 
+	// Utility function - parse a numeric field, with blanks around it allowed
+	// Returns NaN for a blank or unreadable field.  Plain decimals of up to 15
+	// significant digits are converted directly, anything else goes to strtod.
+	double parseDouble( const char *pText, const size_t length);
+
+	// Utility function - parse the integer part of a numeric field, with blanks around it allowed
+	// Returns 0 for a blank or unreadable field
+	std::int64_t parseInt64( const char *pText, const size_t length);
+
+	// A column of decoded field values, one for each record
+	class dbColumn {
+
+	public:
+
+		// The ways a field may be decoded
+		enum e_column_types {
+			CT_DOUBLE = 'D',
+			CT_INT64 = 'I',
+			CT_STRING = 'S',
+			CT_BOOL = 'B'
+		};
+		typedef enum e_column_types E_COLUMN_TYPE;
+
+		// Construction - the field to decode and how
+		dbColumn( const size_t nFieldIndex, const E_COLUMN_TYPE eType);
+
+		// Destruction
+		virtual ~dbColumn();
+
+		// Get the index of the field
+		size_t getField() const { return nField; }
+
+		// Get the decoded type
+		E_COLUMN_TYPE getType() const { return eColumnType; }
+
+		// Get the number of values
+		size_t getValueCount() const { return numValues; }
+
+		// Get the values - only the vector matching the decoded type is filled
+		// Blank fields decode as they do through dbTable::getDouble, getInt64, getString and getBool
+		const std::vector<double> & getDoubles() const { return doubleValues; }
+		const std::vector<std::int64_t> & getInt64s() const { return int64Values; }
+		const std::vector<std::string> & getStrings() const { return stringValues; }
+		const std::vector<BYTE> & getBools() const { return boolValues; }
+
+		// Size the column for a number of values
+		void resize( const size_t numNewValues);
+
+		// Decode one value from its field bytes - distinct values may be decoded concurrently
+		void decodeValue( const size_t nValue, const char *pText, const size_t length);
+
+	protected:
+
+		// The index of the field
+		size_t nField;
+
+		// The decoded type
+		E_COLUMN_TYPE eColumnType;
+
+		// The number of values
+		size_t numValues;
+
+		// The values
+		std::vector<double> doubleValues;
+		std::vector<std::int64_t> int64Values;
+		std::vector<std::string> stringValues;
+		std::vector<BYTE> boolValues;
+
+	};
+	typedef std::vector<dbColumn> CNT_COLUMNS;
+	typedef CNT_COLUMNS::const_iterator CITR_COLUMNS;
+	typedef CNT_COLUMNS::iterator ITR_COLUMNS;
+
+	// A condition on one field of a record
+	class dbPredicate {
+
+	public:
+
+		// The comparisons
+		enum e_predicate_ops {
+			PO_TEXT_EQUALS = 'E',		// Field text, without trailing blanks, equals the text
+			PO_TEXT_PREFIX = 'P',		// Field text starts with the text
+			PO_EQUAL = '=',			// Field number equals the value
+			PO_LESS = '<',			// Field number is less than the value
+			PO_LESS_EQUAL = 'l',		// Field number is at most the value
+			PO_GREATER = '>',		// Field number is greater than the value
+			PO_GREATER_EQUAL = 'g'		// Field number is at least the value
+		};
+		typedef enum e_predicate_ops E_PREDICATE_OP;
+
+		// Construction - a text comparison
+		dbPredicate( const size_t nFieldIndex, const E_PREDICATE_OP eOp, const std::string &strText);
+
+		// Construction - a numeric comparison (blank fields never match)
+		dbPredicate( const size_t nFieldIndex, const E_PREDICATE_OP eOp, const double dblValue);
+
+		// Destruction
+		virtual ~dbPredicate();
+
+		// Get the index of the field
+		size_t getField() const { return nField; }
+
+		// Get the comparison
+		E_PREDICATE_OP getOp() const { return ePredicateOp; }
+
+		// Is it a text comparison?
+		bool isText() const { return( (PO_TEXT_EQUALS == ePredicateOp) || (PO_TEXT_PREFIX == ePredicateOp)); }
+
+		// Get the text to compare against
+		const std::string & getText() const { return strValue; }
+
+		// Get the number to compare against
+		double getValue() const { return value; }
+
+	protected:
+
+		// The index of the field
+		size_t nField;
+
+		// The comparison
+		E_PREDICATE_OP ePredicateOp;
+
+		// The text to compare against
+		std::string strValue;
+
+		// The number to compare against
+		double value;
+
+	};
+	typedef std::vector<dbPredicate> CNT_PREDICATES;
+	typedef CNT_PREDICATES::const_iterator CITR_PREDICATES;
+
+	// A DB table
+	//
+	// Tables read through a FILE seek and read for every record.  Tables
+	// built from a file name or a byte image read records straight from
+	// memory, so the typed field accessors make no system calls and may be
+	// used from several threads at once.  Tables built from an input source
+	// are read once, in order, with nextRecord.
 	class dbTable {
 
 	public:
 
-		// Construction
+		// Construction - read through an open file
 		dbTable( FILE *dbFile);
 
+		// Construction - map the named file
+		dbTable( const char *strDBFile);
+
+		// Construction - from a complete image of the file, which must outlive the table
+		dbTable( const BYTE *pData, const size_t dataSize);
+
+		// Construction - read the header from a source, leaving the records to nextRecord
+		dbTable( InputSource &source);
+
 		// Destruction
 		virtual ~dbTable();
 
@@ -133,8 +287,70 @@ namespace libShape {
 		// Get the raw bytes for a record
 		const BYTE * getRecordBytes(const size_t recNum);
 
+		// Get the raw bytes for the record after the last one read this way - NULL after the last record
+		// The bytes are valid until the next read
+		const BYTE * nextRecord();
+
+		// Are the records read from memory?
+		bool isMapped() const { return( (const BYTE *) 0x0 != pImage); }
+
+		// Get the index of the named field (case is ignored), or -1 if there is no such field
+		long getFieldIndex( const char *strName) const;
+
+		// Get the offset of a field within each record (the deletion flag is at offset 0)
+		size_t getFieldOffset( const size_t nField) const;
+
+		// Is the record marked as deleted?
+		bool isDeleted( const size_t recNum) const;
+
+		// Is the field blank?
+		bool isNull( const size_t recNum, const size_t nField) const;
+
+		// Get the raw bytes of a field - getFields()[nField].getLength() bytes, not terminated
+		const char * getFieldBytes( const size_t recNum, const size_t nField) const;
+
+		// Get a field as text, without trailing blanks
+		std::string getString( const size_t recNum, const size_t nField) const;
+
+		// Get a field as a double (NaN when blank)
+		double getDouble( const size_t recNum, const size_t nField) const;
+
+		// Get the integer part of a field (0 when blank)
+		std::int64_t getInt64( const size_t recNum, const size_t nField) const;
+
+		// Get a logical field - true for T, t, Y or y
+		bool getBool( const size_t recNum, const size_t nField) const;
+
+		// Decode whole columns in one pass over the records
+		// Mapped tables split the records across threads (0 means one per core);
+		// tables read through a FILE are read in blocks on the calling thread
+		void readColumns( CNT_COLUMNS &columns, const unsigned int numThreads = 0);
+
+		// Find the records matching every predicate, as a bitmap - bit (recNum % 64) of word (recNum / 64)
+		// Field bytes are compared in place, so records that fail are never decoded.  Deleted
+		// records are matched like any other.  Threads are used as for readColumns.
+		void scanRecords( const CNT_PREDICATES &predicates, std::vector<std::uint64_t> &bitmap, const unsigned int numThreads = 0);
+
+		// Find the records matching every predicate, as a list of record numbers in order
+		void findRecords( const CNT_PREDICATES &predicates, std::vector<size_t> &recNums, const unsigned int numThreads = 0);
+
 	protected:
 
+		// Decode the header and fields
+		void decodeHeader( const BYTE *pData, const size_t dataSize);
+
+		// Decode the header from the start of the image, and check the records fit
+		void decodeImage();
+
+		// Compute the field offsets and check them against the record size
+		void computeOffsets();
+
+		// Get a record from the image, or read it into the record buffer
+		const BYTE * readRecord( const size_t recNum) const;
+
+		// Check the record and field numbers
+		void checkField( const size_t recNum, const size_t nField) const;
+
 		// The DB file
 		FILE *fileDB;
 
@@ -159,6 +375,71 @@ namespace libShape {
 		// The record buffer
 		BYTE *pRecordBuffer;
 
+		// The mapping of a named file
+		MappedFile *pMapped;
+
+		// The image of the file, when records are read from memory
+		const BYTE *pImage;
+
+		// The size of the image
+		size_t imageSize;
+
+		// The offset of each field within a record
+		std::vector<size_t> fieldOffsets;
+
+		// The source of a streamed table
+		InputSource *pSource;
+
+		// The next record for nextRecord
+		size_t nNextRecord;
+
+	private:
+
+		// Tables may not be copied
+		dbTable( const dbTable &copyTable);
+		dbTable & operator=( const dbTable &copyTable);
+
+	};
+
+	// A view of the bytes of one record, decoded with its table's field layout
+	class dbRecordView {
+
+	public:
+
+		// Construction - an empty view
+		dbRecordView();
+
+		// Construction - the table must outlive the view, and the bytes must stay valid while it is used
+		dbRecordView( const dbTable &table, const BYTE *pRecord);
+
+		// Destruction
+		virtual ~dbRecordView();
+
+		// Is the view empty?
+		bool isEmpty() const { return( (const BYTE *) 0x0 == pRecordBytes); }
+
+		// Get the raw bytes of the record
+		const BYTE * getBytes() const { return pRecordBytes; }
+
+		// Is the record marked as deleted?
+		bool isDeleted() const;
+
+		// Field accessors - as the dbTable accessors of the same names
+		const char * getFieldBytes( const size_t nField) const;
+		bool isNull( const size_t nField) const;
+		std::string getString( const size_t nField) const;
+		double getDouble( const size_t nField) const;
+		std::int64_t getInt64( const size_t nField) const;
+		bool getBool( const size_t nField) const;
+
+	protected:
+
+		// The table
+		const dbTable *pTable;
+
+		// The record
+		const BYTE *pRecordBytes;
+
 	};
 
 };
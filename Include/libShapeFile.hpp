@@ -32,6 +32,9 @@
 
 ***/
 
+// Project includes
+#include <libShape.hpp>
+
 #ifndef ShapeType_hpp
 #define ShapeType_hpp
 
@@ -43,11 +46,12 @@
 #include <string>
 #include <vector>
 
-// Project includes
-#include <libShape.hpp>
-
 namespace libShape {
 
+	// Forward declarations
+	class InputSource;
+	class ShapeArena;
+
 	// Enumerated list of shape types and values
 	enum e_shape_types {
 
@@ -156,7 +160,7 @@ namespace libShape {
 		// Bounding box variables
 		const S_BOUNDING_BOX & getBoundingBox() const { return boundingBox; }
 
-		// See if a point is contained within
+		// See if a point is contained within - implementations must not allocate
 		virtual bool containsPoint( double x, double y) const = 0;
 
 	protected:
@@ -180,14 +184,36 @@ namespace libShape {
 
 	public:
 
-		// The maximum record size to allocate for
+		// The largest record read through a FILE or stream - larger record sizes are rejected as corrupt
 		const static unsigned long MAXIMUM_RECORD_SIZE;
 
 		// The default number of shapes to allocate for
 		const static unsigned long SHAPES_RESERVE_SIZE;
 
-		// Construction
-		Reader( FILE *fShapeFile, const bool bStrict = false);
+		// Every constructor takes bStrict - when set, a record that is not a valid shape (too short, or
+		// of an unknown type) throws rather than being kept as a ShapeInvalid
+
+		// Construction - read through an open file
+		// With read ahead, an I/O thread reads the file while the records are decoded
+		Reader( FILE *fShapeFile, const bool bStrict = false, const bool bReadAhead = false);
+
+		// Construction - memory map the named shape file
+		// The records are decoded by numThreads threads (0 means one per core)
+		Reader( const char *strShapeFile, const bool bStrict = false, const unsigned int numThreads = 1);
+
+		// Construction - from a caller owned image of a shape file
+		// The records are decoded by numThreads threads (0 means one per core)
+		Reader( const BYTE *pData, const size_t dataSize, const bool bStrict = false, const unsigned int numThreads = 1);
+
+		// Construction - from a sequential input source
+		Reader( InputSource &source, const bool bStrict = false);
+
+		// Construction - memory map the named shape file, building the shapes in an arena
+		// The shapes are FlatShapes owned by the arena, which must outlive their use
+		Reader( const char *strShapeFile, ShapeArena &arena, const bool bStrict = false);
+
+		// Construction - from a caller owned image, building the shapes in an arena
+		Reader( const BYTE *pData, const size_t dataSize, ShapeArena &arena, const bool bStrict = false);
 
 		// Destruction
 		virtual ~Reader();
@@ -198,22 +224,37 @@ namespace libShape {
 		// Get the list of shapes
 		const CNT_SHAPES & getShapes() const { return shapes; }
 
-		// Take ownership of the list of shapes
+		// Take ownership of the list of shapes (arena shapes stay owned by the arena)
 		CNT_SHAPES * takeShapes();
 
 	protected:
 
+		// Decode the header and all records of a shape file image
+		void decodeImage( const BYTE *pData, const size_t dataSize, const bool bStrict, const unsigned int numThreads);
+
+		// Decode the header and all records of a sequential input
+		void decodeStream( InputSource &source, const bool bStrict);
+
+		// Release the accumulated shapes
+		void clearShapes();
+
 		// The header file for the shapes
 		S_SHAPE_HEADER header;
 
 		// The actual shapes
 		CNT_SHAPES shapes;
 
+		// The arena holding the shapes (if any)
+		ShapeArena *pArena;
+
 	};
 
 	// Factory function - build shape
 	AbstractShape * buildShape(const int recordNum, const BYTE *pBuffer, const size_t bufSize);
 
+	// Utility function - decode the 100 byte header of a shape (or index) file
+	void decodeShapeHeader( const BYTE *pBuffer, S_SHAPE_HEADER &header);
+
 	// Utilitu function - convert integer to shape type
 	E_SHAPE_TYPE convertIntToShape( const int nShapeValue);
 
@@ -224,13 +265,17 @@ namespace libShape {
 	// > 0 means ptToCheck is on the left side
 	// 0 means ptToCheck is on the line
 	// < 0 means ptToCheck is on the right side
-	int onLeftSide( const S_POINT vertex1, const S_POINT vertex2, const S_POINT ptToCheck);
+	int onLeftSide( const S_POINT &vertex1, const S_POINT &vertex2, const S_POINT &ptToCheck);
 
 	// Utility - see if a point is on the right side of a vertex line
-	bool onRightSide( const S_POINT vertex1, const S_POINT vertex2, const S_POINT ptToCheck);
+	bool onRightSide( const S_POINT &vertex1, const S_POINT &vertex2, const S_POINT &ptToCheck);
 
 	// Calculate winding number
-	int getWindingNumber( const POLYGON polygon, const S_POINT ptToCheck, const bool debug = false);
+	int getWindingNumber( const POLYGON &polygon, const S_POINT &ptToCheck);
+
+	// Calculate winding number - ring held as separate x and y arrays
+	// Coordinates are read every stride values, so interleaved x and y values may be used directly
+	int getWindingNumber( const double *pX, const double *pY, const size_t numPoints, const double x, const double y, const size_t stride = 1);
 
 	///////////////////
 	// SHAPE CLASSES //
@@ -351,6 +396,9 @@ namespace libShape {
 		// Destruction
 		virtual ~ShapePolygon();
 
+		// Get the polygons
+		const CNT_POLYGON & getPolygons() const { return( cntPolygons); }
+
 		// Overrides
 		virtual bool containsPoint( double x, double y) const;
 
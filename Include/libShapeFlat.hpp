@@ -0,0 +1,236 @@
+//
+//  libShapeFlat.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A column oriented store for a whole layer of shapes.  The
+// coordinates of every shape are held in shared x and y arrays,
+// and FlatShape provides the usual shape interface as a view
+// over them.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFile.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEFLAT_HPP
+#define	INCLUDE_LIBSHAPEFLAT_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// A shape whose coordinates are held in separate x and y arrays
+	//
+	// Part n of the shape covers the points partStarts[n] up to (but
+	// not including) partStarts[n + 1] of the x and y arrays.  The
+	// shape does not own any of the arrays.
+	class FlatShape : public AbstractShape {
+
+	public:
+
+		// Construction - over existing arrays
+		FlatShape( const int recordNum, const E_SHAPE_TYPE shapeType, const S_BOUNDING_BOX &box,
+			const size_t numParts, const size_t *pPartStarts, const double *pX, const double *pY);
+
+		// Destruction
+		virtual ~FlatShape();
+
+		// Get the number of parts
+		size_t getPartCount() const { return( nParts); }
+
+		// Get the number of points in a part
+		size_t getPartSize( const size_t nPart) const { return( pStarts[nPart + 1] - pStarts[nPart]); }
+
+		// Get the x coordinates of a part
+		const double * getPartX( const size_t nPart) const { return( pXs + pStarts[nPart]); }
+
+		// Get the y coordinates of a part
+		const double * getPartY( const size_t nPart) const { return( pYs + pStarts[nPart]); }
+
+		// Overrides
+		virtual bool containsPoint( double x, double y) const;
+
+	protected:
+
+		// The number of parts
+		size_t nParts;
+
+		// The start of each part, plus one past the end of the last
+		const size_t *pStarts;
+
+		// The x coordinates
+		const double *pXs;
+
+		// The y coordinates
+		const double *pYs;
+
+	};
+
+	// A layer of shapes stored as flat arrays
+	//
+	// Every coordinate of the layer lives in one x and one y array,
+	// with parts and shapes described by offsets into them.  Only the
+	// x and y values are kept (Z and M values are dropped), and a
+	// whole layer needs only a handful of allocations.
+	class FlatLayer {
+
+	public:
+
+		// Construction - empty
+		FlatLayer();
+
+		// Construction - memory map and decode the named shape file
+		FlatLayer( const char *strShapeFile);
+
+		// Construction - decode a caller owned image of a shape file
+		FlatLayer( const BYTE *pData, const size_t dataSize);
+
+		// Construction - from already decoded shapes
+		FlatLayer( const CNT_SHAPES &shapes);
+
+		// Construction - over arrays held elsewhere (such as a layer cache), laid out as the getters return them
+		// The arrays must outlive the layer, and no shapes may be appended to it
+		FlatLayer( const S_SHAPE_HEADER &shapeHeader, const size_t numShapes, const size_t numParts, const size_t numPoints,
+			const double *pX, const double *pY, const size_t *pParts, const size_t *pShapes,
+			const S_BOUNDING_BOX *pBoxArray, const int *pRecords, const BYTE *pTypes);
+
+		// Copying - copies of a layer over arrays held elsewhere share the arrays
+		FlatLayer( const FlatLayer &copyLayer);
+		FlatLayer & operator=( const FlatLayer &copyLayer);
+
+		// Destruction
+		virtual ~FlatLayer();
+
+		// Get the header information (if built from a shape file)
+		const S_SHAPE_HEADER & getShapeHeader() const { return header; }
+
+		// Get the number of shapes, parts and points
+		size_t getShapeCount() const { return nShapes; }
+		size_t getPartCount() const { return nParts; }
+		size_t getPointCount() const { return nPoints; }
+
+		// Get the coordinate arrays
+		const double * getX() const { return( pXs); }
+		const double * getY() const { return( pYs); }
+
+		// Get the start of every part in the coordinate arrays (getPartCount() + 1 values)
+		const size_t * getPartStarts() const { return( pPartStarts); }
+
+		// Get the first part of every shape (getShapeCount() + 1 values)
+		const size_t * getShapeStarts() const { return( pShapeStarts); }
+
+		// Get the per shape arrays
+		const S_BOUNDING_BOX * getBoundingBoxes() const { return( pBoxes); }
+		const int * getRecordNumbers() const { return( pRecordNums); }
+		const BYTE * getShapeTypes() const { return( pShapeTypes); }
+
+		// Get the per shape values
+		const S_BOUNDING_BOX & getBoundingBox( const size_t nShape) const { return( pBoxes[nShape]); }
+		int getRecordNumber( const size_t nShape) const { return( pRecordNums[nShape]); }
+		E_SHAPE_TYPE getShapeType( const size_t nShape) const { return( (E_SHAPE_TYPE) pShapeTypes[nShape]); }
+
+		// Are the arrays held elsewhere?
+		bool isExternal() const { return( bExternal); }
+
+		// Get a view of a shape - only valid while the layer is unchanged
+		FlatShape getShape( const size_t nShape) const;
+
+		// Append a shape - points, polylines, polygons and flat shapes are copied, null and invalid
+		// shapes are kept without points, and any other shape throws
+		void addShape( const AbstractShape &shape);
+
+		// Append a shape record (the bytes following the record header)
+		void addRecord( const int recordNum, const BYTE *pBuffer, const size_t bufSize);
+
+		// Reorder the shapes along a Hilbert curve through the centres of their boxes, so shapes near
+		// one another are stored near one another.  Record numbers move with their shapes, and the old
+		// index of each shape is returned through pOrder if given.  A layer over arrays held elsewhere
+		// is copied into arrays of its own.  Shape views and trees over the layer must be rebuilt, while
+		// levels of detail built from it hold copies of their own and keep the old order.
+		void sortHilbert( std::vector<size_t> *pOrder = (std::vector<size_t> *) 0x0);
+
+	protected:
+
+		// Decode the header and every record of a shape file image
+		void decodeImage( const BYTE *pData, const size_t dataSize);
+
+		// Append a shape with no points
+		void addEmpty( const int recordNum, const E_SHAPE_TYPE shapeType);
+
+		// Close off the shape just appended
+		void endShape( const int recordNum, const E_SHAPE_TYPE shapeType, const S_BOUNDING_BOX &box);
+
+		// Point the arrays in use at the vectors, after they change
+		void attachVectors();
+
+		// Fail unless shapes may be appended
+		void checkAppend() const;
+
+		// The header of the shape file
+		S_SHAPE_HEADER header;
+
+		// The coordinates
+		std::vector<double> xs;
+		std::vector<double> ys;
+
+		// The part and shape offsets
+		std::vector<size_t> partStarts;
+		std::vector<size_t> shapeStarts;
+
+		// The per shape values
+		std::vector<S_BOUNDING_BOX> boxes;
+		std::vector<int> recordNums;
+		std::vector<BYTE> shapeTypes;
+
+		// The arrays in use - the vectors above, or arrays held elsewhere
+		bool bExternal;
+		size_t nShapes;
+		size_t nParts;
+		size_t nPoints;
+		const double *pXs;
+		const double *pYs;
+		const size_t *pPartStarts;
+		const size_t *pShapeStarts;
+		const S_BOUNDING_BOX *pBoxes;
+		const int *pRecordNums;
+		const BYTE *pShapeTypes;
+
+	};
+
+};
+
+#endif
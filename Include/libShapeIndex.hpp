@@ -0,0 +1,164 @@
+//
+//  libShapeIndex.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Support for the shape index (.shx) file, which holds the
+// offset and length of every record in the companion shape
+// file.  With the index any single record can be read and
+// decoded without walking the shape file.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFile.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEINDEX_HPP
+#define	INCLUDE_LIBSHAPEINDEX_HPP
+
+// Standard includes
+#include <stdio.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// An index entry - converted to native format
+	struct s_index_entry {
+		size_t offset;			// converted to actual bytes, not 16-bit words
+		size_t contentLength;	// converted to actual bytes, not 16-bit words
+	};
+	typedef struct s_index_entry S_INDEX_ENTRY;
+	typedef std::vector<S_INDEX_ENTRY> CNT_INDEX_ENTRIES;
+	typedef CNT_INDEX_ENTRIES::const_iterator CITR_INDEX_ENTRIES;
+	typedef CNT_INDEX_ENTRIES::iterator ITR_INDEX_ENTRIES;
+
+	// A reader class for shape index files
+	class ShapeIndex {
+
+	public:
+
+		// Construction - read the entire index file
+		ShapeIndex( FILE *fIndexFile);
+
+		// Construction - memory map the named index file
+		ShapeIndex( const char *strIndexFile);
+
+		// Construction - from a caller owned image of an index file
+		ShapeIndex( const BYTE *pData, const size_t dataSize);
+
+		// Destruction
+		virtual ~ShapeIndex();
+
+		// Get the header information
+		const S_SHAPE_HEADER & getShapeHeader() const { return header; }
+
+		// Get the number of indexed records
+		size_t getRecordCount() const { return entries.size(); }
+
+		// Get all of the index entries
+		const CNT_INDEX_ENTRIES & getEntries() const { return entries; }
+
+		// Get the index entry for a record number (1 based, as in the shape file)
+		const S_INDEX_ENTRY & getEntry( const int recordNum) const;
+
+	protected:
+
+		// Decode the header and entries of an index file image
+		void decodeImage( const BYTE *pData, const size_t dataSize);
+
+		// The header of the index file
+		S_SHAPE_HEADER header;
+
+		// The index entries
+		CNT_INDEX_ENTRIES entries;
+
+	};
+
+	// A random access reader class for shape files
+	class IndexedReader {
+
+	public:
+
+		// Construction - read the index, leave the shape file for random reads
+		IndexedReader( FILE *fShapeFile, FILE *fIndexFile);
+
+		// Construction - memory map the named shape and index files
+		IndexedReader( const char *strShapeFile, const char *strIndexFile);
+
+		// Destruction
+		virtual ~IndexedReader();
+
+		// Get the header information
+		const S_SHAPE_HEADER & getShapeHeader() const { return header; }
+
+		// Get the index
+		const ShapeIndex & getIndex() const { return *pIndex; }
+
+		// Get the number of records
+		size_t getRecordCount() const { return pIndex->getRecordCount(); }
+
+		// Read and build a single shape (1 based) - the caller owns the result
+		AbstractShape * getShape( const int recordNum);
+
+	protected:
+
+		// Check a record header against its index entry
+		void validateRecord( const int recordNum, const BYTE *pRecord) const;
+
+		// The shape file (for random reads)
+		FILE *fileShape;
+
+		// The shape file mapping (for mapped reads)
+		MappedFile *pShapeMap;
+
+		// The index
+		ShapeIndex *pIndex;
+
+		// The header of the shape file
+		S_SHAPE_HEADER header;
+
+		// The record buffer for random reads
+		std::vector<BYTE> recordBuffer;
+
+	private:
+
+		// Readers may not be copied
+		IndexedReader( const IndexedReader &copyReader);
+		IndexedReader & operator=( const IndexedReader &copyReader);
+
+	};
+
+};
+
+#endif
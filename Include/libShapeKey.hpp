@@ -0,0 +1,136 @@
+//
+//  libShapeKey.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Hash indexes on the key fields of a DB table, which can be saved
+// next to the table so later loads skip the build.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeDB.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEKEY_HPP
+#define	INCLUDE_LIBSHAPEKEY_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace libShape {
+
+	// A hash index from the values of one field to the records holding them
+	//
+	// Keys are the field values with the blanks at both ends trimmed, so
+	// right justified numeric codes are found by their digits alone.  Each
+	// distinct key takes one slot, with the records sharing it chained in
+	// order.  The index holds only record numbers and hashes - the key
+	// bytes are read back from the table, which must outlive the index.
+	class dbKeyIndex {
+
+	public:
+
+		// Construction - build over every record of the table
+		dbKeyIndex( const dbTable &table, const size_t nField);
+
+		// Construction - load the named index file if it was saved for this table and field,
+		// otherwise build and try to save it (the index is usable either way)
+		// The table must have been read from the named DB file - the index file holds its size
+		// and modification time, and is only loaded while they still match
+		dbKeyIndex( const dbTable &table, const size_t nField, const char *strIndexFile, const char *strDBFile);
+
+		// Destruction
+		virtual ~dbKeyIndex();
+
+		// Get the indexed field
+		size_t getField() const { return nKeyField; }
+
+		// Was the index loaded from a file?
+		bool wasLoaded() const { return bLoaded; }
+
+		// Get the number of hash slots
+		size_t getSlotCount() const { return slotRecords.size(); }
+
+		// Find the first record (0 based) holding a key, or -1 if there is none
+		long find( const char *pKey, const size_t keyLength) const;
+		long find( const std::string &strKey) const { return( find( strKey.data(), strKey.size())); }
+
+		// Find every record holding a key, in record order - each record is checked against the key
+		void findAll( const char *pKey, const size_t keyLength, std::vector<size_t> &recNums) const;
+
+		// Load an index file saved for this table, field and DB file - false if it is missing,
+		// does not match or is damaged
+		bool load( const char *strIndexFile, const char *strDBFile);
+
+		// Save the index, stamped with the DB file the table was read from
+		void save( const char *strIndexFile, const char *strDBFile) const;
+
+	protected:
+
+		// Build the slots from the table
+		void build();
+
+		// Does a record hold the trimmed key?
+		bool matchRecord( const size_t recNum, const char *pKey, const size_t keyLength) const;
+
+		// The table
+		const dbTable &keyTable;
+
+		// The indexed field
+		size_t nKeyField;
+
+		// Was the index loaded from a file?
+		bool bLoaded;
+
+		// Each slot holds the first record number plus one (0 when empty) of a key, and its hash
+		std::vector<std::uint32_t> slotRecords;
+		std::vector<std::uint32_t> slotHashes;
+
+		// For each record, the next record number plus one (0 when last) with the same key
+		std::vector<std::uint32_t> nextRecords;
+
+	private:
+
+		// Indexes may not be copied
+		dbKeyIndex( const dbKeyIndex &copyIndex);
+		dbKeyIndex & operator=( const dbKeyIndex &copyIndex);
+
+	};
+
+};
+
+#endif
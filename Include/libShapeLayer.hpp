@@ -0,0 +1,127 @@
+//
+//  libShapeLayer.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Streaming a layer - the shape file and its DB file read together,
+// record by record.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeDB.hpp>
+#include <libShapeSource.hpp>
+#include <libShapeStream.hpp>
+
+#ifndef	INCLUDE_LIBSHAPELAYER_HPP
+#define	INCLUDE_LIBSHAPELAYER_HPP
+
+// Standard includes
+#include <stdio.h>
+#include <stddef.h>
+
+namespace libShape {
+
+	// A reader of a layer - each shape together with its attribute row
+	//
+	// The shape file and the DB file are both streamed in record order,
+	// each through a block of read-ahead, so a pass over the whole layer
+	// is two sequential reads.  The nth shape is paired with the nth row.
+	class LayerReader {
+
+	public:
+
+		// Construction - stream the two sources, which must outlive the reader
+		// A block size of 0 reads the sources directly
+		LayerReader( InputSource &shapeSource, InputSource &dbSource, const size_t blockSize = BlockSource::DEFAULT_BLOCK_SIZE);
+
+		// Construction - open and stream the named files
+		LayerReader( const char *strShapeFile, const char *strDBFile, const size_t blockSize = BlockSource::DEFAULT_BLOCK_SIZE);
+
+		// Destruction
+		virtual ~LayerReader();
+
+		// Get the header of the shape file
+		const S_SHAPE_HEADER & getShapeHeader() const { return pShapes -> getShapeHeader(); }
+
+		// Get the DB table - its records can only be read through this reader
+		const dbTable & getTable() const { return *pTable; }
+
+		// Get the number of pairs read so far
+		unsigned long getRecordsRead() const { return pShapes -> getRecordsRead(); }
+
+		// Move to the next shape and row - false after the last shape
+		bool next();
+
+		// Get the current shape - valid until the next move
+		const AbstractShape & getShape() const;
+
+		// Get the current row - valid until the next move
+		const dbRecordView & getRow() const { return currentRow; }
+
+	protected:
+
+		// Set up the readers over the sources
+		void openSources( InputSource &shapeSource, InputSource &dbSource, const size_t blockSize);
+
+		// Release everything
+		void release();
+
+		// The files, when opened by name
+		FILE *fShapeFile;
+		FILE *fDBFile;
+		FileSource *pShapeFileSource;
+		FileSource *pDBFileSource;
+
+		// The read-ahead blocks
+		BlockSource *pShapeBlocks;
+		BlockSource *pDBBlocks;
+
+		// The readers
+		StreamReader *pShapes;
+		dbTable *pTable;
+
+		// The current shape and row
+		AbstractShape *pCurrent;
+		dbRecordView currentRow;
+
+	private:
+
+		// Readers may not be copied
+		LayerReader( const LayerReader &copyReader);
+		LayerReader & operator=( const LayerReader &copyReader);
+
+	};
+
+};
+
+#endif
@@ -0,0 +1,129 @@
+//
+//  libShapeMapped.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A read-only memory mapping of an entire file.  This allows
+// the shape and database files to be decoded directly from
+// the page cache, without per-record reads or copies into
+// an intermediate buffer.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShape.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEMAPPED_HPP
+#define	INCLUDE_LIBSHAPEMAPPED_HPP
+
+// Standard includes
+#include <stdio.h>
+#include <stddef.h>
+
+// STL includes
+#include <cstdint>
+
+namespace libShape {
+
+	// The size and modification time of a file, to tell when anything derived from it is stale
+	struct s_file_stamp {
+		std::uint64_t fileSize;
+		std::int64_t modSeconds;
+		std::int64_t modNanos;
+	};
+	typedef struct s_file_stamp S_FILE_STAMP;
+
+	// Utility function - get the stamp of a file - false if it cannot be found
+	bool getFileStamp( const char *strFileName, S_FILE_STAMP &stamp);
+
+	// Utility function - does a file still match its stamp?
+	bool matchFileStamp( const char *strFileName, const S_FILE_STAMP &stamp);
+
+	// A read-only mapping of a file
+	class MappedFile {
+
+	public:
+
+		// How the mapped bytes will be read - passed on to the kernel as a paging hint
+		enum e_access_pattern {
+			ACCESS_SEQUENTIAL = 0,
+			ACCESS_RANDOM = 1,
+			ACCESS_NORMAL = 2
+		};
+		typedef enum e_access_pattern E_ACCESS_PATTERN;
+
+		// Construction - map the named file
+		MappedFile( const char *strFileName, const E_ACCESS_PATTERN eAccess = ACCESS_SEQUENTIAL);
+
+		// Construction - map an already opened file
+		MappedFile( FILE *fFile, const E_ACCESS_PATTERN eAccess = ACCESS_SEQUENTIAL);
+
+		// Destruction
+		virtual ~MappedFile();
+
+		// Was the mapping successful?
+		bool isValid() const { return( 0x0 == nError); }
+
+		// Get the errno of a failed mapping
+		int getError() const { return( nError); }
+
+		// Get the mapped bytes
+		const BYTE * getData() const { return( pData); }
+
+		// Get the number of mapped bytes
+		size_t getSize() const { return( dataSize); }
+
+	protected:
+
+		// Map an open descriptor
+		void mapDescriptor( const int fd, const E_ACCESS_PATTERN eAccess);
+
+		// The mapped bytes
+		const BYTE *pData;
+
+		// The number of mapped bytes
+		size_t dataSize;
+
+		// The errno of a failed mapping
+		int nError;
+
+	private:
+
+		// Mappings may not be copied
+		MappedFile( const MappedFile &copyMap);
+		MappedFile & operator=( const MappedFile &copyMap);
+
+	};
+
+};
+
+#endif
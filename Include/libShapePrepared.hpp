@@ -0,0 +1,115 @@
+//
+//  libShapePrepared.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Polygons prepared once for many point queries, with their edges
+// indexed by horizontal slab.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFile.hpp>
+#include <libShapeFlat.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEPREPARED_HPP
+#define	INCLUDE_LIBSHAPEPREPARED_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// An edge of a prepared polygon
+	struct s_prepared_edge {
+		double curX;
+		double curY;
+		double nextX;
+		double nextY;
+		size_t nRing;
+	};
+	typedef struct s_prepared_edge S_PREPARED_EDGE;
+
+	// A polygon prepared for repeated point queries
+	//
+	// The rings of the polygon are split into horizontal slabs, each
+	// holding every edge that spans part of it, so a query only tests
+	// the edges near its y instead of every edge of every ring.  The
+	// answers are those of ShapePolygon::containsPoint, except that
+	// points outside the extent of the rings are never contained.
+	class PreparedPolygon : public AbstractShape {
+
+	public:
+
+		// Construction - from a decoded polygon, which need not outlive this one
+		PreparedPolygon( const ShapePolygon &polygon);
+
+		// Construction - from a flat polygon (such as one of an arena or a flat layer), which need not outlive this one
+		PreparedPolygon( const FlatShape &polygon);
+
+		// Destruction
+		virtual ~PreparedPolygon();
+
+		// Get the number of slabs
+		size_t getSlabCount() const { return( slabStarts.empty() ? 0 : slabStarts.size() - 1); }
+
+		// Get the number of edges held in the slabs (edges spanning several slabs count once for each)
+		size_t getEntryCount() const { return( slabEdges.size()); }
+
+		// Overrides
+		virtual bool containsPoint( double x, double y) const;
+
+	protected:
+
+		// Split the rings into slabs - ring n holds the points from pRingStarts[n] up to pRingStarts[n + 1]
+		void prepare( const double *pX, const double *pY, const size_t *pRingStarts, const size_t numRings);
+
+		// The extent of the rings
+		S_BOUNDING_BOX extent;
+
+		// The height of each slab
+		double slabHeight;
+
+		// The first edge of each slab, plus one past the end of the last
+		std::vector<size_t> slabStarts;
+
+		// The edges of every slab, in ring order
+		std::vector<S_PREPARED_EDGE> slabEdges;
+
+	};
+
+};
+
+#endif
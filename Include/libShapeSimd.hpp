@@ -0,0 +1,80 @@
+//
+//  libShapeSimd.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Vectorized geometry kernels.  The instruction set is picked once
+// at run time from what the CPU supports, with a scalar fallback, and
+// every choice gives exactly the same answers.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShape.hpp>
+
+#ifndef	INCLUDE_LIBSHAPESIMD_HPP
+#define	INCLUDE_LIBSHAPESIMD_HPP
+
+// Standard includes
+#include <stddef.h>
+
+namespace libShape {
+
+	// The instruction sets the geometry kernels may use
+	enum e_simd_level {
+		SIMD_NONE = 0,
+		SIMD_SSE2 = 1,
+		SIMD_AVX2 = 2
+	};
+	typedef e_simd_level E_SIMD_LEVEL;
+
+	// Utility function - get the instruction set in use (the best the CPU supports, unless lowered)
+	E_SIMD_LEVEL getSimdLevel();
+
+	// Utility function - change the instruction set in use, capped at what the CPU supports
+	// Returns the instruction set now in use
+	E_SIMD_LEVEL setSimdLevel( const E_SIMD_LEVEL level);
+
+	// Utility function - winding contribution of one edge against a point
+	// 1 for an upward crossing with the point on the left, -1 for a
+	// downward crossing with the point on the right, 0 otherwise
+	int getEdgeCrossing( const double curX, const double curY, const double nextX, const double nextY, const double x, const double y);
+
+	// Utility function - total winding contribution of the edges from each of the first
+	// numEdges points to the point after it (numEdges + 1 points are read)
+	// Coordinates are read every stride values.  Every instruction set gives exactly
+	// the same result as summing getEdgeCrossing.
+	int countCrossings( const double *pX, const double *pY, const size_t numEdges, const double x, const double y, const size_t stride = 1);
+
+};
+
+#endif
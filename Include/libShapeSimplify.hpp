@@ -0,0 +1,128 @@
+//
+//  libShapeSimplify.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Simplified copies of flat layers at several tolerances, for drawing
+// and coarse queries.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFlat.hpp>
+
+#ifndef	INCLUDE_LIBSHAPESIMPLIFY_HPP
+#define	INCLUDE_LIBSHAPESIMPLIFY_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// Simplified copies of a flat layer at several tolerances
+	//
+	// Every part of every shape is simplified with Douglas-Peucker, so no
+	// point dropped lies further than the tolerance (in the units of the
+	// coordinates) from the part that remains.  Polygon rings keep at
+	// least four points, and a shape whose simplified rings would cross
+	// or touch one another is simplified again at half the tolerance,
+	// and failing that kept whole.  Parts no larger than the tolerance in
+	// either direction are dropped, except the largest part of each
+	// shape.  Points are kept as they are.
+	//
+	// Each level is a flat layer holding its own copy of the shapes,
+	// record numbers and shape types of the original as they were when
+	// the levels were built, so reordering the original afterwards (as
+	// sortHilbert does) leaves the levels as they were.  Level 0 is the
+	// original itself, which must outlive the levels.
+	class LevelsOfDetail {
+
+	public:
+
+		// Construction - simplify the layer at each tolerance, across numThreads threads (0 means one per core)
+		LevelsOfDetail( const FlatLayer &layer, const std::vector<double> &tolerances, const unsigned int numThreads = 0);
+
+		// Destruction
+		virtual ~LevelsOfDetail();
+
+		// Get the number of levels - level 0 is the original layer, and the rest follow by increasing tolerance
+		size_t getLevelCount() const { return( levels.size() + 1); }
+
+		// Get the tolerance of a level
+		double getTolerance( const size_t nLevel) const;
+
+		// Get a level
+		const FlatLayer & getLevel( const size_t nLevel) const;
+
+		// Find the cheapest level meeting a tolerance - the coarsest whose tolerance is no more than that given
+		size_t findLevel( const double tolerance) const;
+		const FlatLayer & getLevelFor( const double tolerance) const { return( getLevel( findLevel( tolerance))); }
+
+	protected:
+
+		// A simplified level
+		struct s_detail_level {
+			double tolerance;
+			std::vector<double> xs;
+			std::vector<double> ys;
+			std::vector<size_t> partStarts;
+			std::vector<size_t> shapeStarts;
+			std::vector<S_BOUNDING_BOX> boxes;
+			std::vector<int> recordNums;
+			std::vector<BYTE> shapeTypes;
+			FlatLayer *pLayer;
+		};
+		typedef struct s_detail_level S_DETAIL_LEVEL;
+
+		// Simplify the layer at one tolerance
+		void buildLevel( S_DETAIL_LEVEL &level, const unsigned int numThreads);
+
+		// The original layer
+		const FlatLayer &original;
+
+		// The simplified levels
+		std::vector<S_DETAIL_LEVEL *> levels;
+
+	private:
+
+		// Levels may not be copied
+		LevelsOfDetail( const LevelsOfDetail &copyLevels);
+		LevelsOfDetail & operator=( const LevelsOfDetail &copyLevels);
+
+	};
+
+};
+
+#endif
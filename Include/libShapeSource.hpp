@@ -0,0 +1,217 @@
+//
+//  libShapeSource.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Sequential sources of file bytes.  Readers that consume a
+// file front to back take an InputSource, so that files,
+// memory images and other inputs can all be decoded the same
+// way.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShape.hpp>
+
+#ifndef	INCLUDE_LIBSHAPESOURCE_HPP
+#define	INCLUDE_LIBSHAPESOURCE_HPP
+
+// Standard includes
+#include <stdio.h>
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// The shared state of a read-ahead source
+	struct s_read_ahead;
+	typedef struct s_read_ahead S_READ_AHEAD;
+
+	// A sequential source of file bytes
+	class InputSource {
+
+	public:
+
+		// Construction
+		InputSource();
+
+		// Destruction
+		virtual ~InputSource();
+
+		// Read up to bufSize bytes - returns 0 only at the end of the input
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize) = 0;
+
+		// Read exactly bufSize bytes unless the input ends first
+		size_t readFully( BYTE *pBuffer, const size_t bufSize);
+
+	};
+
+	// A source reading from an open file
+	class FileSource : public InputSource {
+
+	public:
+
+		// Construction
+		FileSource( FILE *fFile);
+
+		// Destruction
+		virtual ~FileSource();
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// The file
+		FILE *fileInput;
+
+	};
+
+	// A source reading another source in large blocks
+	//
+	// Small reads are served from the block, so a reader pulling one
+	// record at a time still reads its input in long sequential runs.
+	// Reads of a whole block or more go straight to the other source.
+	class BlockSource : public InputSource {
+
+	public:
+
+		// The default block size
+		const static size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+		// Construction - the other source must outlive this one
+		BlockSource( InputSource &source, const size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+		// Destruction
+		virtual ~BlockSource();
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// The other source
+		InputSource &input;
+
+		// The block
+		std::vector<BYTE> block;
+
+		// The valid bytes of the block
+		size_t blockFill;
+
+		// The next unread byte of the block
+		size_t blockPos;
+
+	};
+
+	// A source reading ahead of its reader on a background thread
+	//
+	// An I/O thread fills a ring of large buffers from the other source
+	// while the reader consumes the filled ones, so reading and decoding
+	// overlap.  Errors on the I/O thread are rethrown to the reader.
+	class ReadAheadSource : public InputSource {
+
+	public:
+
+		// The default ring
+		const static size_t DEFAULT_BUFFER_COUNT = 4;
+		const static size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+		// Construction - read ahead of another source, which must outlive this one
+		ReadAheadSource( InputSource &source, const size_t numBuffers = DEFAULT_BUFFER_COUNT, const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+		// Construction - read ahead of an open file, advising the system of sequential reads
+		ReadAheadSource( FILE *fFile, const size_t numBuffers = DEFAULT_BUFFER_COUNT, const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+		// Destruction - stops the I/O thread
+		virtual ~ReadAheadSource();
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// Size the ring and start the I/O thread
+		void start( const size_t numBuffers, const size_t bufferSize);
+
+		// The I/O thread
+		void fillBuffers();
+
+		// The file source, when reading a file
+		FileSource *pFileSource;
+
+		// The other source
+		InputSource &input;
+
+		// The ring and the state shared with the I/O thread
+		S_READ_AHEAD *pState;
+
+	private:
+
+		// Sources may not be copied
+		ReadAheadSource( const ReadAheadSource &copySource);
+		ReadAheadSource & operator=( const ReadAheadSource &copySource);
+
+	};
+
+	// A source reading from a caller owned memory image
+	class MemorySource : public InputSource {
+
+	public:
+
+		// Construction
+		MemorySource( const BYTE *pData, const size_t dataSize);
+
+		// Destruction
+		virtual ~MemorySource();
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// The image
+		const BYTE *pImage;
+
+		// The size of the image
+		size_t imageSize;
+
+		// The current position
+		size_t curPos;
+
+	};
+
+};
+
+#endif
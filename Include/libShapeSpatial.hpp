@@ -0,0 +1,206 @@
+//
+//  libShapeSpatial.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A packed R-tree over the bounding boxes of a layer, used to find
+// the few shapes worth testing against a point or box.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFlat.hpp>
+
+#ifndef	INCLUDE_LIBSHAPESPATIAL_HPP
+#define	INCLUDE_LIBSHAPESPATIAL_HPP
+
+// Standard includes
+#include <stddef.h>
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// A node of the tree
+	//
+	// Leaf entries hold the index of their item in nFirst.  Every
+	// other node holds the range of its children.
+	struct s_rtree_node {
+		S_BOUNDING_BOX box;
+		size_t nFirst;
+		size_t nCount;
+	};
+	typedef struct s_rtree_node S_RTREE_NODE;
+	typedef std::vector<S_RTREE_NODE> CNT_RTREE_NODES;
+
+	// A read only R-tree over bounding boxes
+	//
+	// The tree is bulk loaded once with Sort-Tile-Recursive packing
+	// and cannot be changed.  Items are identified by their index in
+	// the source - the position in the shape container, the shape
+	// number of a flat layer or the position in a box array.  Null
+	// and invalid shapes have no extent and are never indexed.
+	//
+	// Queries never allocate, other than to grow the caller's results.
+	class ShapeRTree {
+
+	public:
+
+		// The default number of children of each node
+		const static size_t DEFAULT_NODE_SIZE;
+
+		// Construction - over the boxes of decoded shapes, which must outlive the tree
+		ShapeRTree( const CNT_SHAPES &shapes, const size_t nodeSize = DEFAULT_NODE_SIZE);
+
+		// Construction - over the shapes of a flat layer, which must outlive the tree
+		ShapeRTree( const FlatLayer &layer, const size_t nodeSize = DEFAULT_NODE_SIZE);
+
+		// Construction - over an array of boxes
+		ShapeRTree( const S_BOUNDING_BOX *pBoxes, const size_t numBoxes, const size_t nodeSize = DEFAULT_NODE_SIZE);
+
+		// Construction - over nodes held elsewhere (such as a layer cache), as returned by getNodes
+		// for a tree over the shapes of a flat layer - the nodes and layer must outlive the tree
+		ShapeRTree( const FlatLayer &layer, const S_RTREE_NODE *pNodeArray, const size_t numNodeArray, const size_t numItems);
+
+		// Destruction
+		virtual ~ShapeRTree();
+
+		// Get the number of items indexed
+		size_t getCount() const { return( nItems); }
+
+		// Get the nodes - the leaf entries, then each level in turn, ending with the root
+		const S_RTREE_NODE * getNodes() const { return( pNodes); }
+		size_t getNodeCount() const { return( numNodes); }
+
+		// Get the bounds of everything indexed
+		S_BOUNDING_BOX getBounds() const;
+
+		// Find every item whose box holds a point - the indexes are appended to results
+		size_t queryPoint( const double x, const double y, std::vector<size_t> &results) const;
+
+		// Find every item whose box overlaps a box - the indexes are appended to results
+		size_t queryBox( const S_BOUNDING_BOX &box, std::vector<size_t> &results) const;
+
+		// Find the candidate shapes whose box holds a point - only for trees over decoded shapes
+		size_t queryPoint( const double x, const double y, CNT_SHAPES &results) const;
+
+		// Find the item whose box is nearest a point (the lowest index on a tie) - false if the tree is empty
+		bool queryNearest( const double x, const double y, size_t &nIndex, double *pDistance = (double *) 0x0) const;
+
+		// Find the lowest indexed shape containing a point - the index, or -1 if none
+		// Only for trees over decoded shapes or flat layers
+		long findContaining( const double x, const double y) const;
+
+		// Get the record number of an item - only for trees over decoded shapes or flat layers
+		int getRecordNumber( const size_t nIndex) const;
+
+	protected:
+
+		// Bulk load the tree from its leaf entries
+		void build( const size_t nodeSize);
+
+		// Point the nodes in use at the built nodes
+		void attachNodes();
+
+		// Search below a node
+		void searchBox( const size_t nNode, const S_BOUNDING_BOX &box, std::vector<size_t> &results) const;
+		void searchShapes( const size_t nNode, const S_BOUNDING_BOX &box, CNT_SHAPES &results) const;
+		void searchNearest( const size_t nNode, const double x, const double y, double &bestDistance2, long &nBest) const;
+		long searchContaining( const size_t nNode, const double x, const double y, long nBest) const;
+
+		// See if the shape of an item contains a point
+		bool itemContains( const size_t nIndex, const double x, const double y) const;
+
+		// The number of items
+		size_t nItems;
+
+		// The nodes built - the leaf entries, then each level in turn, ending with the root
+		CNT_RTREE_NODES nodes;
+
+		// The nodes in use - those built, or nodes held elsewhere
+		const S_RTREE_NODE *pNodes;
+		size_t numNodes;
+
+		// The source, if any
+		const CNT_SHAPES *pShapes;
+		const FlatLayer *pLayer;
+
+	private:
+
+		// Trees may not be copied
+		ShapeRTree( const ShapeRTree &copyTree);
+		ShapeRTree & operator=( const ShapeRTree &copyTree);
+
+	};
+
+	// Utility function - find the shape containing each of a batch of points
+	// pRecordNums receives, for each point, the record number of the lowest
+	// indexed shape of the tree containing it, or -1 if there is none.  The
+	// points are split into blocks across numThreads threads (0 means one per
+	// core), and each block is worked through in spatial order.  On one
+	// thread nothing is allocated.
+	void classifyPoints( const ShapeRTree &tree, const double *pX, const double *pY, const size_t numPoints,
+		int *pRecordNums, const unsigned int numThreads = 0);
+
+	// A visitor of the pairs found by a spatial join
+	class JoinVisitor {
+
+	public:
+
+		// Construction
+		JoinVisitor();
+
+		// Destruction
+		virtual ~JoinVisitor();
+
+		// Visit a point record and the record of a polygon containing it - calls are never concurrent
+		// Return false to stop the join
+		virtual bool visitPair( const int pointRecord, const int polygonRecord) = 0;
+
+	};
+
+	// Utility function - join the points of one layer to the polygons of another containing them
+	// The points are partitioned along a Z curve, and the partitions are matched across
+	// numThreads threads (0 means one per core), each against only the polygons whose
+	// boxes overlap it.  Candidates are filtered by box before the exact test, which uses
+	// polygons prepared once.  Pairs reach the visitor a partition at a time - those of a
+	// point arrive together in polygon order, but partitions arrive in no set order - so
+	// the whole result is never held.  Returns the number of pairs visited.
+	size_t joinPointsToPolygons( const CNT_SHAPES &points, const CNT_SHAPES &polygons, JoinVisitor &visitor,
+		const unsigned int numThreads = 0);
+	size_t joinPointsToPolygons( const Reader &pointReader, const Reader &polygonReader, JoinVisitor &visitor,
+		const unsigned int numThreads = 0);
+
+};
+
+#endif
@@ -0,0 +1,124 @@
+//
+//  libShapeStream.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A streaming reader for shape files.  Rather than collecting
+// every shape, as the Reader class does, each shape is built,
+// handed to the caller and discarded, so memory use does not
+// grow with the size of the file.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFile.hpp>
+#include <libShapeSource.hpp>
+
+#ifndef	INCLUDE_LIBSHAPESTREAM_HPP
+#define	INCLUDE_LIBSHAPESTREAM_HPP
+
+// STL includes
+#include <vector>
+
+namespace libShape {
+
+	// A visitor of streamed shapes
+	class ShapeVisitor {
+
+	public:
+
+		// Construction
+		ShapeVisitor();
+
+		// Destruction
+		virtual ~ShapeVisitor();
+
+		// Visit a shape - the shape is only valid during the call
+		// Return false to stop the stream
+		virtual bool visitShape( const AbstractShape &shape) = 0;
+
+	};
+
+	// A streaming reader class for shape files
+	class StreamReader {
+
+	public:
+
+		// Construction - reads the header
+		// When strict, a record that is not a valid shape (too short, or of an unknown type) throws
+		// rather than being returned as a ShapeInvalid
+		StreamReader( InputSource &source, const bool bStrict = false);
+
+		// Destruction
+		virtual ~StreamReader();
+
+		// Get the header information
+		const S_SHAPE_HEADER & getShapeHeader() const { return header; }
+
+		// Get the number of records read so far
+		unsigned long getRecordsRead() const { return nCurRec; }
+
+		// Read and build the next shape - the caller owns the result
+		// Returns NULL at the end of the file
+		AbstractShape * nextShape();
+
+		// Hand every remaining shape to the visitor - returns the number visited
+		unsigned long visitShapes( ShapeVisitor &visitor);
+
+	protected:
+
+		// The input
+		InputSource &input;
+
+		// The header file for the shapes
+		S_SHAPE_HEADER header;
+
+		// The number of records read
+		unsigned long nCurRec;
+
+		// Do invalid records throw?
+		bool bStrictRecords;
+
+		// The reused record buffer
+		std::vector<BYTE> recordBuffer;
+
+	private:
+
+		// Readers may not be copied
+		StreamReader( const StreamReader &copyReader);
+		StreamReader & operator=( const StreamReader &copyReader);
+
+	};
+
+};
+
+#endif
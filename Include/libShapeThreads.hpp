@@ -0,0 +1,79 @@
+//
+//  libShapeThreads.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// A minimal pool for splitting work across threads.  Work is
+// described as numbered blocks, which are handed out to the
+// threads in order until none remain.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShape.hpp>
+
+#ifndef	INCLUDE_LIBSHAPETHREADS_HPP
+#define	INCLUDE_LIBSHAPETHREADS_HPP
+
+// Standard includes
+#include <stddef.h>
+
+namespace libShape {
+
+	// A unit of parallel work, split into numbered blocks
+	class ParallelTask {
+
+	public:
+
+		// Construction
+		ParallelTask();
+
+		// Destruction
+		virtual ~ParallelTask();
+
+		// Process a single block - called concurrently from the worker threads
+		virtual void runBlock( const size_t nBlock) = 0;
+
+	};
+
+	// Utility function - resolve a requested thread count (0 means one per core)
+	unsigned int getThreadCount( const unsigned int numThreads);
+
+	// Utility function - run every block of a task across a pool of threads
+	// Blocks are handed out in order as threads become free; the first
+	// exception thrown by any block stops the remaining blocks and is
+	// rethrown to the caller once every thread has finished
+	void runParallel( ParallelTask &task, const size_t numBlocks, const unsigned int numThreads);
+
+};
+
+#endif
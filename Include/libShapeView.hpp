@@ -0,0 +1,224 @@
+//
+//  libShapeView.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Zero copy views over the records of a shape file image.  A view
+// reads the bounding box, parts and points of a record in place,
+// so nothing is allocated or copied to inspect a shape.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeFile.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEVIEW_HPP
+#define	INCLUDE_LIBSHAPEVIEW_HPP
+
+// Standard includes
+#include <stddef.h>
+
+namespace libShape {
+
+	// A cursor over the records of a shape file image
+	//
+	// Nothing is copied - the cursor only points into the image, so
+	// the image must outlive it.
+	class RecordCursor {
+
+	public:
+
+		// Construction - positioned before the first record
+		RecordCursor( const BYTE *pData, const size_t dataSize);
+
+		// Destruction
+		virtual ~RecordCursor();
+
+		// Advance to the next record - returns false at the end of the image
+		bool next();
+
+		// Get the current record number
+		int getRecordNumber() const { return( nRecordNum); }
+
+		// Get the current shape type
+		E_SHAPE_TYPE getShapeType() const { return( eShapeType); }
+
+		// Get the current record (the bytes following the record header)
+		const BYTE * getRecord() const { return( pRecord); }
+		size_t getRecordSize() const { return( recSize); }
+
+		// Get the current shape content (the bytes following the shape type)
+		const BYTE * getContent() const { return( pRecord + 4); }
+		size_t getContentSize() const { return( (4 > recSize) ? 0 : recSize - 4); }
+
+	protected:
+
+		// The image
+		const BYTE *pImage;
+		size_t imageSize;
+
+		// The position of the next record header
+		size_t nextPos;
+
+		// The number of records visited
+		unsigned long nCurRec;
+
+		// The current record
+		int nRecordNum;
+		E_SHAPE_TYPE eShapeType;
+		const BYTE *pRecord;
+		size_t recSize;
+
+	};
+
+	// A view of a point record
+	class PointView {
+
+	public:
+
+		// Construction - from the bytes following the shape type, as for ShapePoint
+		PointView( const int recordNum, const BYTE *pBuffer, const size_t bufSize);
+
+		// Get the record number
+		int getRecordNumber() const { return( nRecordNum); }
+
+		// Get the coordinates
+		double getX() const { return( * ((double *) (pContent + 0))); }
+		double getY() const { return( * ((double *) (pContent + 8))); }
+		S_POINT getPoint() const;
+
+		// Get the bounding box - the point itself
+		S_BOUNDING_BOX getBoundingBox() const;
+
+		// See if a point matches
+		bool containsPoint( double x, double y) const;
+
+	protected:
+
+		// The record number
+		int nRecordNum;
+
+		// The content
+		const BYTE *pContent;
+
+	};
+
+	// A view of a multi-part (polyline or polygon) record
+	//
+	// The points of part n are getPartStart(n) up to (but not including)
+	// getPartStart(n) + getPartSize(n).
+	class PartsView {
+
+	public:
+
+		// Construction - from the bytes following the shape type
+		// Checks the record exactly as ShapePolyline and ShapePolygon do
+		PartsView( const int recordNum, const E_SHAPE_TYPE shapeType, const BYTE *pBuffer, const size_t bufSize);
+
+		// Get the record number
+		int getRecordNumber() const { return( nRecordNum); }
+
+		// Get the shape type
+		E_SHAPE_TYPE getShapeType() const { return( eShapeType); }
+
+		// Get the bounding box
+		S_BOUNDING_BOX getBoundingBox() const;
+
+		// Get the number of parts and points
+		int getPartCount() const { return( numParts); }
+		int getPointCount() const { return( numPoints); }
+
+		// Get the first point of a part
+		int getPartStart( const int nPart) const {
+			return( (0 == nPart) ? 0 : * ((int *) (pContent + 40 + (4 * nPart))));
+		}
+
+		// Get the number of points in a part
+		int getPartSize( const int nPart) const {
+			int nEnd = ((numParts - 1) == nPart) ? numPoints : * ((int *) (pContent + 40 + (4 * (nPart + 1))));
+			return( nEnd - getPartStart( nPart));
+		}
+
+		// Get a point
+		double getX( const int nPoint) const { return( * ((double *) (pPoints + (16 * nPoint) + 0))); }
+		double getY( const int nPoint) const { return( * ((double *) (pPoints + (16 * nPoint) + 8))); }
+		S_POINT getPoint( const int nPoint) const;
+
+		// Get the interleaved x and y values of every point
+		const double * getXY() const { return( (const double *) pPoints); }
+
+	protected:
+
+		// The record number
+		int nRecordNum;
+
+		// The shape type
+		E_SHAPE_TYPE eShapeType;
+
+		// The content
+		const BYTE *pContent;
+
+		// The points
+		const BYTE *pPoints;
+
+		// The number of parts and points
+		int numParts;
+		int numPoints;
+
+	};
+
+	// A view of a polyline record
+	class PolylineView : public PartsView {
+
+	public:
+
+		// Construction - from the bytes following the shape type, as for ShapePolyline
+		PolylineView( const int recordNum, const BYTE *pBuffer, const size_t bufSize);
+
+	};
+
+	// A view of a polygon record
+	class PolygonView : public PartsView {
+
+	public:
+
+		// Construction - from the bytes following the shape type, as for ShapePolygon
+		PolygonView( const int recordNum, const BYTE *pBuffer, const size_t bufSize);
+
+		// See if a point is contained within - same rules as ShapePolygon
+		bool containsPoint( double x, double y) const;
+
+	};
+
+};
+
+#endif
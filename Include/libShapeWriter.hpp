@@ -0,0 +1,200 @@
+//
+//  libShapeWriter.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Writing shape files - the shapes, their index and their DB records,
+// in one buffered pass.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeDB.hpp>
+#include <libShapeFile.hpp>
+#include <libShapeFlat.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEWRITER_HPP
+#define	INCLUDE_LIBSHAPEWRITER_HPP
+
+// Standard includes
+#include <stdio.h>
+#include <stddef.h>
+
+// STL includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace libShape {
+
+	// A writer of shape, index and DB files
+	//
+	// Records are encoded straight into one large buffer for each file,
+	// which is written out whole as it fills, so the three files are
+	// produced in a single sequential pass.  The counts and extent in the
+	// file headers are only known at the end, and are written by close().
+	//
+	// Each record is a shape plus the fields set since the previous
+	// record - fields not set are left blank.  Shapes are written with
+	// their parts and points as they stand (Z and M values are dropped),
+	// and must be of the type of the file, or null.  Records are numbered
+	// from 1 in the order they are added.
+	class Writer {
+
+	public:
+
+		// The default size of each file buffer
+		const static size_t DEFAULT_BUFFER_SIZE;
+
+		// Construction - create the .shp, .shx and .dbf files of a base name
+		// The shape type must be SHAPE_POINT, SHAPE_POLYLINE or SHAPE_POLYGON
+		Writer( const char *strBaseName, const E_SHAPE_TYPE eShapeType, const CNT_FIELDS &fields,
+			const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+		// Destruction - closes the files if close() was not called, ignoring any error
+		virtual ~Writer();
+
+		// Get the shape type
+		E_SHAPE_TYPE getShapeType() const { return( eFileType); }
+
+		// Get the fields
+		const CNT_FIELDS & getFields() const { return( dbFields); }
+
+		// Get the number of records added
+		size_t getRecordCount() const { return( numRecords); }
+
+		// Set a field of the next record
+		// Text is truncated to the field length.  Numbers are formatted with
+		// the decimal count of the field and must fit it; NaN is written blank.
+		void setString( const size_t nField, const char *pText, const size_t length);
+		void setString( const size_t nField, const std::string &strValue) { setString( nField, strValue.data(), strValue.size()); }
+		void setDouble( const size_t nField, const double value);
+		void setInt64( const size_t nField, const std::int64_t value);
+		void setBool( const size_t nField, const bool value);
+
+		// Set every field of the next record from the bytes of a record with the same fields
+		void setRecordBytes( const BYTE *pRecord, const size_t recordSize);
+
+		// Append a record - the shape (NULL for a null shape) and the fields set since the last
+		void addRecord( const AbstractShape *pShape);
+
+		// Append a record of a flat layer's shape and the fields set since the last
+		void addRecord( const FlatLayer &layer, const size_t nShape);
+
+		// Write the headers and close the files
+		void close();
+
+	protected:
+
+		// A file being written
+		struct s_output_file {
+			FILE *fFile;
+			std::vector<BYTE> buffer;
+			size_t bufferUsed;
+			std::uint64_t fileSize;
+		};
+		typedef struct s_output_file S_OUTPUT_FILE;
+
+		// Open one of the files
+		void openFile( S_OUTPUT_FILE &file, const char *strExtension, const size_t bufferSize);
+
+		// Close every file that is open - false if any failed
+		bool closeFiles();
+
+		// Make room in a buffer, writing it out if it is full
+		BYTE * reserve( S_OUTPUT_FILE &file, const size_t numBytes);
+
+		// Write out a buffer - false if it failed
+		bool flush( S_OUTPUT_FILE &file);
+
+		// Start a shape record holding a number of content bytes - writes its
+		// header and index entry, and returns where the content goes
+		BYTE * beginShape( const size_t contentSize);
+
+		// Write a polyline or polygon, from either decoded or flat parts
+		void writeParts( const E_SHAPE_TYPE eShapeType, const size_t numParts, const size_t numPoints,
+			const CNT_POINTS *pParts, const FlatShape *pFlat);
+
+		// Finish a record - the fields, and the extent of its shape
+		void endRecord( const bool bShapeExtent, const S_BOUNDING_BOX &box);
+
+		// Get the bytes of a field of the next record
+		char * getFieldBytes( const size_t nField);
+
+		// Fail once the files are closed
+		void checkOpen() const;
+
+		// Write the headers at the start of the files - false if it failed
+		bool writeHeaders();
+
+		// The base name of the files
+		std::string strBase;
+
+		// The shape type of the files
+		E_SHAPE_TYPE eFileType;
+
+		// The fields, and the offset of each in a record
+		CNT_FIELDS dbFields;
+		std::vector<size_t> fieldOffsets;
+
+		// The size of each DB record
+		size_t recSize;
+
+		// The next DB record
+		std::vector<BYTE> nextRecord;
+
+		// The number of records added
+		size_t numRecords;
+
+		// The extent of every shape added
+		S_BOUNDING_BOX extent;
+		bool bHasExtent;
+
+		// The files
+		S_OUTPUT_FILE shapeFile;
+		S_OUTPUT_FILE indexFile;
+		S_OUTPUT_FILE dbFile;
+
+		// Have the files been closed?
+		bool bClosed;
+
+	private:
+
+		// Writers may not be copied
+		Writer( const Writer &copyWriter);
+		Writer & operator=( const Writer &copyWriter);
+
+	};
+
+};
+
+#endif
@@ -0,0 +1,221 @@
+//
+//  libShapeZip.hpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+//
+// Reading gzipped shape files and members of zip archives straight
+// into the readers, without extracting them first.  Needs zlib.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Project includes
+#include <libShapeSource.hpp>
+
+#ifndef	INCLUDE_LIBSHAPEZIP_HPP
+#define	INCLUDE_LIBSHAPEZIP_HPP
+
+// Only with zlib - build with "make ZLIB=yes", and define LIBSHAPE_ZLIB when including
+#if defined( LIBSHAPE_ZLIB)
+
+// Standard includes
+#include <stdio.h>
+#include <stddef.h>
+#include <zlib.h>
+
+// STL includes
+#include <string>
+#include <vector>
+
+namespace libShape {
+
+	// A source inflating the compressed bytes of another source
+	class InflateSource : public InputSource {
+
+	public:
+
+		// Construction - gzip (or zlib) streams, or raw deflate data as held in zip archives
+		// The other source must outlive this one
+		InflateSource( InputSource &source, const bool bGzip);
+
+		// Destruction
+		virtual ~InflateSource();
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// The compressed source
+		InputSource &input;
+
+		// Gzip streams may hold several members one after another
+		bool bGzipStream;
+
+		// The compressed bytes read but not yet inflated
+		std::vector<BYTE> inBuffer;
+
+		// The inflater
+		z_stream stream;
+
+		// Has the compressed data ended?
+		bool bEnded;
+
+	private:
+
+		// Sources may not be copied
+		InflateSource( const InflateSource &copySource);
+		InflateSource & operator=( const InflateSource &copySource);
+
+	};
+
+	// A source reading a gzipped file, such as a .shp.gz
+	class GzipSource : public InflateSource {
+
+	public:
+
+		// Construction - the other source must outlive this one
+		GzipSource( InputSource &source);
+
+		// Destruction
+		virtual ~GzipSource();
+
+	};
+
+	// A member of a zip archive
+	struct s_zip_member {
+		std::string name;
+		int method;			// 0 stored, 8 deflated
+		bool bEncrypted;
+		unsigned long crc;
+		size_t compressedSize;
+		size_t size;
+		size_t localOffset;		// Of the member's local header
+	};
+	typedef struct s_zip_member S_ZIP_MEMBER;
+	typedef std::vector<S_ZIP_MEMBER> CNT_ZIP_MEMBERS;
+
+	// The directory of a zip archive, such as a downloaded shape file bundle
+	// Zip64 archives, encrypted members and methods other than stored and deflated are not supported
+	class ZipArchive {
+
+	public:
+
+		// Construction - open the named archive
+		ZipArchive( const char *strArchive);
+
+		// Construction - read an open archive, which must stay open while it is used
+		ZipArchive( FILE *fArchive);
+
+		// Destruction
+		virtual ~ZipArchive();
+
+		// Get the members
+		const CNT_ZIP_MEMBERS & getMembers() const { return members; }
+
+		// Find a member by its full name, or -1
+		long findMember( const char *strName) const;
+
+		// Find the first member whose name ends with the suffix, ignoring case (such as ".shp"), or -1
+		long findMemberBySuffix( const char *strSuffix) const;
+
+		// Read bytes at an offset - returns the number read
+		size_t readAt( BYTE *pBuffer, const size_t bufSize, const size_t offset) const;
+
+	protected:
+
+		// Read the central directory
+		void readDirectory();
+
+		// The archive
+		FILE *fileArchive;
+
+		// Was the archive opened by name?
+		bool bOwnFile;
+
+		// The members
+		CNT_ZIP_MEMBERS members;
+
+	private:
+
+		// Archives may not be copied
+		ZipArchive( const ZipArchive &copyArchive);
+		ZipArchive & operator=( const ZipArchive &copyArchive);
+
+	};
+
+	// A source reading one member of a zip archive, inflating as it goes
+	// Several members of one archive may be read at once, each with its own source
+	class ZipMemberSource : public InputSource {
+
+	public:
+
+		// Construction - the archive must outlive the source
+		ZipMemberSource( const ZipArchive &archive, const size_t nMember);
+
+		// Destruction
+		virtual ~ZipMemberSource();
+
+		// Overrides - the check value and size of the member are verified as soon as its last byte
+		// is read, and a member whose data runs past its size is rejected
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize);
+
+	protected:
+
+		// Read the member's bytes, inflating them if need be
+		size_t readStored( BYTE *pBuffer, const size_t bufSize);
+
+		// The member
+		S_ZIP_MEMBER member;
+
+		// The stored bytes of the member
+		InputSource *pStored;
+
+		// The inflater, for deflated members
+		InflateSource *pInflate;
+
+		// The running check value and count of the bytes read
+		unsigned long crc;
+		size_t numRead;
+
+	private:
+
+		// Sources may not be copied
+		ZipMemberSource( const ZipMemberSource &copySource);
+		ZipMemberSource & operator=( const ZipMemberSource &copySource);
+
+	};
+
+};
+
+#endif
+
+#endif
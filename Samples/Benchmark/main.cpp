@@ -0,0 +1,735 @@
+//
+//  main.cpp
+//  
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+ MIT License
+
+ Copyright (c) 2026 the libShape contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ ***/
+
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// STL includes
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Project includes
+#include <libShape.hpp>
+
+//
+// Global variables
+//
+// g_argError
+//		"true" if one or more program args are invalid
+//
+// g_showArgs
+//		"true" if the program arguments should be output
+//
+// g_strDir
+//		The directory the generated files are written to
+//
+// g_strFields
+//		The field layout of the generated database
+//
+// g_eShapeType
+//		The type of the generated shapes
+//
+// g_numRecords, g_numVertices, g_numParts
+//		The number of records, vertices per ring and parts per shape
+//
+// g_numIterations
+//		The number of times each timed benchmark is run (the best is reported)
+//
+// g_nSeed
+//		The seed of the generator
+//
+
+static bool g_argError = false;
+static bool g_showArgs = false;
+static const char *g_strDir = ".";
+static const char *g_strFields = "C10,C20,N10,N14.3,L1";
+static libShape::E_SHAPE_TYPE g_eShapeType = libShape::SHAPE_POLYGON;
+static unsigned long g_numRecords = 20000;
+static unsigned long g_numVertices = 64;
+static unsigned long g_numParts = 2;
+static unsigned long g_numIterations = 3;
+static unsigned long g_nSeed = 1;
+
+//
+// Show program arguments
+//
+
+void showArgs( const char *progName) {
+
+	printf( "\nProgram usage: %s [ options ] [ -? | -help | --help ]\n", progName);
+	printf( "\n");
+	printf( "\t-dir path        Directory for the generated files (default .)\n");
+	printf( "\t-records n       Number of records (default 20000)\n");
+	printf( "\t-vertices n      Vertices per ring or line (default 64)\n");
+	printf( "\t-parts n         Parts per shape (default 2)\n");
+	printf( "\t-type t          polygon, polyline or point (default polygon)\n");
+	printf( "\t-fields list     Field layout, e.g. C10,N14.3,L1 (default C10,C20,N10,N14.3,L1)\n");
+	printf( "\t-iterations n    Runs of each benchmark, best reported (default 3)\n");
+	printf( "\t-seed n          Generator seed (default 1)\n");
+	printf( "\n\n");
+
+}
+
+//
+// Decode the program arguments
+//
+// Every option takes a single value.  Decoded information is
+// stored in global variables
+//
+
+void decodeProgramArgs( int argc, char **argv) {
+
+	// Loop over the program arguments
+	for( int i = 1 ; i < argc ; ++ i) {
+
+		// Show args?
+		if(
+		   (0x0 == strcmp( argv [i], "-?")) ||
+		   (0x0 == strcmp( argv [i], "-h")) ||
+		   (0x0 == strcmp( argv [i], "-help")) ||
+		   (0x0 == strcmp( argv [i], "--help"))
+		   ) {
+			g_showArgs = true;
+			continue;
+		}
+
+		// Everything else needs a value
+		if( (argv [i][0] != '-') || ((i + 1) >= argc)) {
+			fprintf( stderr, "Unknown argument: %s\n", argv [i]);
+			g_argError = true;
+			continue;
+		}
+		const char *strOption = argv [i] + 1;
+		const char *strValue = argv [++ i];
+		if( 0x0 == strcmp( strOption, "dir")) {
+			g_strDir = strValue;
+		}
+		else if( 0x0 == strcmp( strOption, "fields")) {
+			g_strFields = strValue;
+		}
+		else if( 0x0 == strcmp( strOption, "records")) {
+			g_numRecords = strtoul( strValue, (char **) 0x0, 10);
+		}
+		else if( 0x0 == strcmp( strOption, "vertices")) {
+			g_numVertices = strtoul( strValue, (char **) 0x0, 10);
+		}
+		else if( 0x0 == strcmp( strOption, "parts")) {
+			g_numParts = strtoul( strValue, (char **) 0x0, 10);
+		}
+		else if( 0x0 == strcmp( strOption, "iterations")) {
+			g_numIterations = strtoul( strValue, (char **) 0x0, 10);
+		}
+		else if( 0x0 == strcmp( strOption, "seed")) {
+			g_nSeed = strtoul( strValue, (char **) 0x0, 10);
+		}
+		else if( 0x0 == strcmp( strOption, "type")) {
+			if( 0x0 == strcmp( strValue, "polygon")) g_eShapeType = libShape::SHAPE_POLYGON;
+			else if( 0x0 == strcmp( strValue, "polyline")) g_eShapeType = libShape::SHAPE_POLYLINE;
+			else if( 0x0 == strcmp( strValue, "point")) g_eShapeType = libShape::SHAPE_POINT;
+			else {
+				fprintf( stderr, "Unknown shape type: %s\n", strValue);
+				g_argError = true;
+			}
+		}
+		else {
+			fprintf( stderr, "Unknown switch: %s\n", argv [i - 1]);
+			g_argError = true;
+		}
+
+	} // endfor loop over arguments
+
+	// Sensible values?
+	if( (0 == g_numRecords) || (3 > g_numVertices) || (0 == g_numParts) || (0 == g_numIterations)) {
+		fprintf( stderr, "Error - records, parts and iterations must be positive, and vertices at least 3!\n");
+		g_argError = true;
+	}
+
+}
+
+///////////////
+// GENERATOR //
+///////////////
+
+//
+// A small deterministic random number generator, so the same
+// arguments always produce the same files on every platform
+//
+
+class Generator {
+
+public:
+
+	Generator( const unsigned long nSeed) : nState( 0x853C49E6748FEA9BULL ^ nSeed) {
+	}
+
+	// Next value in [0, 1)
+	double next() {
+		nState = (nState * 6364136223846793005ULL) + 1442695040888963407ULL;
+		return( (double) (nState >> 11) / 9007199254740992.0);
+	}
+
+	// Next value in [low, high)
+	double next( const double low, const double high) {
+		return( low + ((high - low) * next()));
+	}
+
+protected:
+
+	unsigned long long nState;
+
+};
+
+// Append little and big endian values
+static void putLE32( std::vector<libShape::BYTE> &buffer, const int nValue) {
+	for( int nByte = 0; 4 > nByte; ++ nByte) buffer.push_back( (libShape::BYTE) ((unsigned int) nValue >> (8 * nByte)));
+}
+static void putBE32( std::vector<libShape::BYTE> &buffer, const int nValue) {
+	for( int nByte = 3; 0 <= nByte; -- nByte) buffer.push_back( (libShape::BYTE) ((unsigned int) nValue >> (8 * nByte)));
+}
+static void putDouble( std::vector<libShape::BYTE> &buffer, const double dValue) {
+	const libShape::BYTE *pBytes = (const libShape::BYTE *) &dValue;
+	buffer.insert( buffer.end(), pBytes, pBytes + sizeof( double));
+}
+
+// Write a whole buffer to a file
+static void writeFile( const std::string &strPath, const std::vector<libShape::BYTE> &buffer) {
+	FILE *fOut = fopen( strPath.c_str(), "wb");
+	if( (FILE *) 0x0 == fOut) {
+		throw( "Failed to create output file");
+	}
+	size_t nWritten = buffer.empty() ? 0 : fwrite( &buffer[0], 1, buffer.size(), fOut);
+	fclose( fOut);
+	if( buffer.size() != nWritten) {
+		throw( "Failed to write output file");
+	}
+}
+
+// The main file and index header
+static void putShapeHeader( std::vector<libShape::BYTE> &buffer, const size_t fileLength, const libShape::S_BOUNDING_BOX &box) {
+	putBE32( buffer, 9994);
+	for( int nUnused = 0; 5 > nUnused; ++ nUnused) putBE32( buffer, 0);
+	putBE32( buffer, (int) (fileLength / 2));
+	putLE32( buffer, 1000);
+	putLE32( buffer, g_eShapeType);
+	putDouble( buffer, box.Xmin);
+	putDouble( buffer, box.Ymin);
+	putDouble( buffer, box.Xmax);
+	putDouble( buffer, box.Ymax);
+	for( int nUnused = 0; 4 > nUnused; ++ nUnused) putDouble( buffer, 0.0);
+}
+
+//
+// Generate the .shp, .shx and .dbf files
+//
+// Shapes are scattered over the continental US.  Polygons have
+// a clockwise outer ring followed by counter-clockwise holes, each
+// ring closed; polylines use the same vertices without closing.
+//
+
+void generateFiles( const std::string &strBase) {
+
+	Generator gen( g_nSeed);
+	std::vector<libShape::BYTE> records;
+	std::vector<libShape::BYTE> index;
+	libShape::S_BOUNDING_BOX fileBox = { 0.0, 0.0, 0.0, 0.0 };
+
+	for( unsigned long nRecord = 0; g_numRecords > nRecord; ++ nRecord) {
+
+		// Build the record content
+		std::vector<libShape::BYTE> content;
+		libShape::S_BOUNDING_BOX box;
+		putLE32( content, g_eShapeType);
+		double cx = gen.next( -120.0, -70.0);
+		double cy = gen.next( 25.0, 50.0);
+		if( libShape::SHAPE_POINT == g_eShapeType) {
+			putDouble( content, cx);
+			putDouble( content, cy);
+			box.Xmin = box.Xmax = cx;
+			box.Ymin = box.Ymax = cy;
+		}
+		else {
+			std::vector<double> xs, ys;
+			std::vector<int> starts;
+			double radius = gen.next( 0.05, 0.5);
+			bool bPolygon = (libShape::SHAPE_POLYGON == g_eShapeType);
+			for( unsigned long nPart = 0; g_numParts > nPart; ++ nPart) {
+				starts.push_back( (int) xs.size());
+				double partRadius = radius * ((0 == nPart) ? 1.0 : (0.5 / g_numParts) * (nPart + 1));
+				double direction = ((0 == nPart) || !bPolygon) ? -1.0 : 1.0;
+				for( unsigned long nVertex = 0; g_numVertices > nVertex; ++ nVertex) {
+					double angle = direction * 2.0 * M_PI * nVertex / g_numVertices;
+					double scale = partRadius * gen.next( 0.8, 1.0);
+					xs.push_back( cx + scale * cos( angle));
+					ys.push_back( cy + scale * sin( angle));
+				}
+				if( bPolygon) {
+					xs.push_back( xs[starts.back()]);
+					ys.push_back( ys[starts.back()]);
+				}
+			}
+			box.Xmin = box.Xmax = xs[0];
+			box.Ymin = box.Ymax = ys[0];
+			for( size_t nPoint = 1; xs.size() > nPoint; ++ nPoint) {
+				if( xs[nPoint] < box.Xmin) box.Xmin = xs[nPoint];
+				if( xs[nPoint] > box.Xmax) box.Xmax = xs[nPoint];
+				if( ys[nPoint] < box.Ymin) box.Ymin = ys[nPoint];
+				if( ys[nPoint] > box.Ymax) box.Ymax = ys[nPoint];
+			}
+			putDouble( content, box.Xmin);
+			putDouble( content, box.Ymin);
+			putDouble( content, box.Xmax);
+			putDouble( content, box.Ymax);
+			putLE32( content, (int) starts.size());
+			putLE32( content, (int) xs.size());
+			for( size_t nPart = 0; starts.size() > nPart; ++ nPart) putLE32( content, starts[nPart]);
+			for( size_t nPoint = 0; xs.size() > nPoint; ++ nPoint) {
+				putDouble( content, xs[nPoint]);
+				putDouble( content, ys[nPoint]);
+			}
+		}
+
+		// Grow the file bounds
+		if( 0 == nRecord) {
+			fileBox = box;
+		}
+		else {
+			if( box.Xmin < fileBox.Xmin) fileBox.Xmin = box.Xmin;
+			if( box.Ymin < fileBox.Ymin) fileBox.Ymin = box.Ymin;
+			if( box.Xmax > fileBox.Xmax) fileBox.Xmax = box.Xmax;
+			if( box.Ymax > fileBox.Ymax) fileBox.Ymax = box.Ymax;
+		}
+
+		// Index entry, record header and content
+		putBE32( index, (int) ((100 + records.size()) / 2));
+		putBE32( index, (int) (content.size() / 2));
+		putBE32( records, (int) (nRecord + 1));
+		putBE32( records, (int) (content.size() / 2));
+		records.insert( records.end(), content.begin(), content.end());
+
+	}
+
+	// The shape and index files
+	std::vector<libShape::BYTE> fileBytes;
+	putShapeHeader( fileBytes, 100 + records.size(), fileBox);
+	fileBytes.insert( fileBytes.end(), records.begin(), records.end());
+	writeFile( strBase + ".shp", fileBytes);
+	fileBytes.clear();
+	putShapeHeader( fileBytes, 100 + index.size(), fileBox);
+	fileBytes.insert( fileBytes.end(), index.begin(), index.end());
+	writeFile( strBase + ".shx", fileBytes);
+
+	// Decode the field layout - type letter, length and optional decimals
+	std::vector<char> types;
+	std::vector<int> lengths, decimals;
+	const char *pSpec = g_strFields;
+	while( '\0' != *pSpec) {
+		char cType = *pSpec ++;
+		char *pEnd = (char *) 0x0;
+		long nLength = strtol( pSpec, &pEnd, 10);
+		long nDecimals = 0;
+		if( '.' == *pEnd) nDecimals = strtol( pEnd + 1, &pEnd, 10);
+		if( ((0 == strchr( "CNL", cType)) && (0 == strchr( "cnl", cType))) || (1 > nLength) || (254 < nLength) || (0 > nDecimals) || (nLength <= nDecimals)) {
+			throw( "Invalid field layout");
+		}
+		types.push_back( (char) (cType & ~0x20));
+		lengths.push_back( (int) nLength);
+		decimals.push_back( (int) nDecimals);
+		pSpec = pEnd;
+		if( ',' == *pSpec) ++ pSpec;
+		else if( '\0' != *pSpec) throw( "Invalid field layout");
+	}
+
+	// The database header and field descriptors
+	size_t recordSize = 1;
+	for( size_t nField = 0; lengths.size() > nField; ++ nField) recordSize += lengths[nField];
+	size_t headerSize = 32 + (32 * types.size()) + 1;
+	fileBytes.clear();
+	fileBytes.push_back( 3);
+	fileBytes.push_back( 119);
+	fileBytes.push_back( 1);
+	fileBytes.push_back( 1);
+	putLE32( fileBytes, (int) g_numRecords);
+	fileBytes.push_back( (libShape::BYTE) (headerSize & 0xFF));
+	fileBytes.push_back( (libShape::BYTE) (headerSize >> 8));
+	fileBytes.push_back( (libShape::BYTE) (recordSize & 0xFF));
+	fileBytes.push_back( (libShape::BYTE) (recordSize >> 8));
+	fileBytes.resize( 32, 0);
+	for( size_t nField = 0; types.size() > nField; ++ nField) {
+		// Room for any field number - the names of the few fields a table can hold fit in 11 bytes
+		char fieldName [32 + 1];
+		memset( fieldName, 0x0, sizeof( fieldName));
+		snprintf( fieldName, sizeof( fieldName), "FIELD%lu", nField + 1);
+		fileBytes.insert( fileBytes.end(), fieldName, fieldName + 11);
+		fileBytes.push_back( types[nField]);
+		fileBytes.resize( fileBytes.size() + 4, 0);
+		fileBytes.push_back( (libShape::BYTE) lengths[nField]);
+		fileBytes.push_back( (libShape::BYTE) decimals[nField]);
+		fileBytes.resize( fileBytes.size() + 14, 0);
+	}
+	fileBytes.push_back( '\r');
+
+	// And the records
+	char value [256 + 1];
+	for( unsigned long nRecord = 0; g_numRecords > nRecord; ++ nRecord) {
+		fileBytes.push_back( ' ');
+		for( size_t nField = 0; types.size() > nField; ++ nField) {
+			int nLength = lengths[nField];
+			switch( types[nField]) {
+				case 'C' :
+					snprintf( value, sizeof( value), "%-*.*s", nLength, nLength, (std::string( "Record ") + std::to_string( nRecord + 1) + " field " + std::to_string( nField + 1)).c_str());
+					break;
+				case 'N' : {
+					// Keep clear of the width, allowing for rounding and the decimal point
+					int numDigits = nLength - ((0 < decimals[nField]) ? (decimals[nField] + 1) : 0);
+					double maxValue = (1 < numDigits) ? (pow( 10.0, numDigits - 1) - 1.0) : 0.0;
+					double scale = pow( 10.0, decimals[nField]);
+					snprintf( value, sizeof( value), "%*.*f", nLength, decimals[nField], floor( gen.next( 0.0, maxValue) * scale) / scale);
+					break;
+				}
+				default :
+					snprintf( value, sizeof( value), "%-*s", nLength, (0.5 > gen.next()) ? "T" : "F");
+					break;
+			}
+			fileBytes.insert( fileBytes.end(), value, value + nLength);
+		}
+	}
+	fileBytes.push_back( 0x1A);
+	writeFile( strBase + ".dbf", fileBytes);
+
+}
+
+////////////
+// TIMING //
+////////////
+
+// Seconds since an arbitrary start
+static double now() {
+	return( std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Report a result
+static void report( const char *strName, const double seconds, const double numBytes, const double numItems, const char *strItems) {
+	printf( "%-32s %10.3f ms", strName, seconds * 1000.0);
+	if( 0.0 < numBytes) {
+		printf( " %10.1f MB/s", (numBytes / (1024.0 * 1024.0)) / seconds);
+	}
+	else {
+		printf( " %15s", "");
+	}
+	printf( " %14.0f %s/s\n", numItems / seconds, strItems);
+}
+
+// Get the size of a file
+static size_t fileSize( const std::string &strPath) {
+	struct stat fileStat;
+	if( 0 != stat( strPath.c_str(), &fileStat)) {
+		throw( "Unable to stat generated file");
+	}
+	return( (size_t) fileStat.st_size);
+}
+
+//////////
+// MAIN //
+//////////
+
+int main( int argc, char **argv) {
+
+	int nRetCode = EXIT_FAILURE;
+
+	// Decode the program arguments
+	decodeProgramArgs( argc, argv);
+	if( g_showArgs || g_argError) {
+		showArgs( argv[0]);
+		exit( g_argError ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+
+	// Wrap it all
+	try {
+
+		// Generate the files
+		std::string strBase = std::string( g_strDir) + "/benchmark";
+		double startTime = now();
+		generateFiles( strBase);
+		std::string strShapeFile = strBase + ".shp";
+		std::string strDBFile = strBase + ".dbf";
+		size_t shapeBytes = fileSize( strShapeFile);
+		printf( "\nGenerated %lu records (%lu parts of %lu vertices) in %.1f ms - %s, %lu bytes\n\n",
+			g_numRecords, g_numParts, g_numVertices, (now() - startTime) * 1000.0, strShapeFile.c_str(), shapeBytes);
+
+		// Reader load - memory mapped
+		double bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			libShape::Reader reader( strShapeFile.c_str());
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "Reader load (mapped)", bestTime, (double) shapeBytes, (double) g_numRecords, "records");
+
+		// Reader load - FILE
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			FILE *fShapeFile = fopen( strShapeFile.c_str(), "rb");
+			if( (FILE *) 0x0 == fShapeFile) throw( "Failed to open shapefile");
+			startTime = now();
+			libShape::Reader reader( fShapeFile, false);
+			double elapsed = now() - startTime;
+			fclose( fShapeFile);
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "Reader load (FILE)", bestTime, (double) shapeBytes, (double) g_numRecords, "records");
+
+		// Reader load - FILE, read on a background thread while decoding
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			FILE *fShapeFile = fopen( strShapeFile.c_str(), "rb");
+			if( (FILE *) 0x0 == fShapeFile) throw( "Failed to open shapefile");
+			startTime = now();
+			libShape::Reader reader( fShapeFile, false, true);
+			double elapsed = now() - startTime;
+			fclose( fShapeFile);
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "Reader load (FILE, read ahead)", bestTime, (double) shapeBytes, (double) g_numRecords, "records");
+
+		// buildShape over every record of the mapped image
+		libShape::MappedFile shapeMap( strShapeFile.c_str());
+		if( !shapeMap.isValid()) throw( "Failed to map shapefile");
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			libShape::RecordCursor cursor( shapeMap.getData(), shapeMap.getSize());
+			while( cursor.next()) {
+				delete libShape::buildShape( cursor.getRecordNumber(), cursor.getRecord(), cursor.getRecordSize());
+			}
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "buildShape", bestTime, (double) shapeBytes, (double) g_numRecords, "records");
+
+		// dbTable::getRecordBytes over every record
+		FILE *fDBFile = fopen( strDBFile.c_str(), "rb");
+		if( (FILE *) 0x0 == fDBFile) throw( "Failed to open database file");
+		libShape::dbTable table( fDBFile);
+		bestTime = 1e30;
+		volatile unsigned long nChecksum = 0;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			for( size_t nRecord = 0; table.getRecordCount() > nRecord; ++ nRecord) {
+				nChecksum += table.getRecordBytes( nRecord)[1];
+			}
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		fclose( fDBFile);
+		report( "dbTable::getRecordBytes", bestTime, (double) (table.getRecordCount() * table.getRecordSize()), (double) table.getRecordCount(), "records");
+
+		// Typed field access over every field of every record of the mapped table
+		libShape::dbTable mappedTable( strDBFile.c_str());
+		const libShape::CNT_FIELDS &fields = mappedTable.getFields();
+		bestTime = 1e30;
+		volatile double sumValues = 0.0;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			for( size_t nRecord = 0; mappedTable.getRecordCount() > nRecord; ++ nRecord) {
+				for( size_t nField = 0; fields.size() > nField; ++ nField) {
+					switch( fields[nField].getType()) {
+						case libShape::dbField::FT_NUMBER :
+							sumValues += mappedTable.getDouble( nRecord, nField);
+							break;
+						case libShape::dbField::FT_LOGICAL :
+							sumValues += mappedTable.getBool( nRecord, nField) ? 1.0 : 0.0;
+							break;
+						default :
+							sumValues += mappedTable.getString( nRecord, nField).size();
+							break;
+					}
+				}
+			}
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "dbTable typed fields (mapped)", bestTime, (double) (mappedTable.getRecordCount() * mappedTable.getRecordSize()), (double) (mappedTable.getRecordCount() * fields.size()), "fields");
+
+		// LayerReader - shapes and rows streamed together
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			libShape::LayerReader layer( strShapeFile.c_str(), strDBFile.c_str());
+			while( layer.next()) {
+				nChecksum += layer.getRow().getBytes()[1];
+			}
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "LayerReader", bestTime, (double) (shapeBytes + fileSize( strDBFile)), (double) g_numRecords, "records");
+
+		// LayerCache - written once from a decoded layer and its tree, then mapped in place
+		std::string strCacheFile = strBase + ".cache";
+		{
+			libShape::FlatLayer flatLayer( strShapeFile.c_str());
+			libShape::ShapeRTree flatTree( flatLayer);
+			libShape::LayerCache::write( strCacheFile.c_str(), strShapeFile.c_str(), flatLayer, &flatTree);
+		}
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			startTime = now();
+			libShape::LayerCache cache( strCacheFile.c_str(), strShapeFile.c_str());
+			if( !cache.isValid()) throw( "Failed to open layer cache");
+			nChecksum += cache.getLayer().getShapeCount();
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "LayerCache open", bestTime, (double) fileSize( strCacheFile), (double) g_numRecords, "records");
+
+		// Writer - a flat layer and its records written back out
+		std::string strCopyBase = strBase + "_copy";
+		{
+			libShape::FlatLayer flatLayer( strShapeFile.c_str());
+			bestTime = 1e30;
+			for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+				startTime = now();
+				libShape::Writer writer( strCopyBase.c_str(), (libShape::E_SHAPE_TYPE) flatLayer.getShapeHeader().shapeType, mappedTable.getFields());
+				for( size_t nShape = 0; flatLayer.getShapeCount() > nShape; ++ nShape) {
+					writer.setRecordBytes( mappedTable.getRecordBytes( nShape), mappedTable.getRecordSize());
+					writer.addRecord( flatLayer, nShape);
+				}
+				writer.close();
+				double elapsed = now() - startTime;
+				if( elapsed < bestTime) bestTime = elapsed;
+			}
+		}
+		report( "Writer", bestTime, (double) (fileSize( strCopyBase + ".shp") + fileSize( strCopyBase + ".shx") + fileSize( strCopyBase + ".dbf")), (double) g_numRecords, "records");
+		remove( (strCopyBase + ".shp").c_str());
+		remove( (strCopyBase + ".shx").c_str());
+		remove( (strCopyBase + ".dbf").c_str());
+
+		// LevelsOfDetail - two levels, at a ten thousandth and a thousandth of the layer width
+		{
+			libShape::FlatLayer flatLayer( strShapeFile.c_str());
+			double layerWidth = flatLayer.getShapeHeader().boundingBox.Xmax - flatLayer.getShapeHeader().boundingBox.Xmin;
+			std::vector<double> tolerances;
+			tolerances.push_back( layerWidth / 10000.0);
+			tolerances.push_back( layerWidth / 1000.0);
+			bestTime = 1e30;
+			for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+				startTime = now();
+				libShape::LevelsOfDetail levels( flatLayer, tolerances);
+				nChecksum += levels.getLevel( levels.getLevelCount() - 1).getPointCount();
+				double elapsed = now() - startTime;
+				if( elapsed < bestTime) bestTime = elapsed;
+			}
+			report( "LevelsOfDetail build", bestTime, 0.0, (double) (flatLayer.getPointCount() * tolerances.size()), "points");
+		}
+
+		// FlatLayer::sortHilbert - a freshly decoded layer reordered each run
+		bestTime = 1e30;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			libShape::FlatLayer flatLayer( strShapeFile.c_str());
+			startTime = now();
+			flatLayer.sortHilbert();
+			double elapsed = now() - startTime;
+			nChecksum += flatLayer.getRecordNumber( 0);
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "FlatLayer sortHilbert", bestTime, 0.0, (double) g_numRecords, "records");
+
+		// containsPoint - a fixed set of points within the box of every shape
+		const int POINTS_PER_SHAPE = 16;
+		libShape::Reader reader( strShapeFile.c_str());
+		const libShape::CNT_SHAPES &shapes = reader.getShapes();
+		std::vector<double> queryX, queryY;
+		Generator queryGen( g_nSeed + 1);
+		for( size_t nShape = 0; shapes.size() > nShape; ++ nShape) {
+			const libShape::S_BOUNDING_BOX &box = shapes[nShape]->getBoundingBox();
+			for( int nPoint = 0; POINTS_PER_SHAPE > nPoint; ++ nPoint) {
+				queryX.push_back( queryGen.next( box.Xmin, box.Xmax));
+				queryY.push_back( queryGen.next( box.Ymin, box.Ymax));
+			}
+		}
+		bestTime = 1e30;
+		unsigned long numContained = 0;
+		for( unsigned long nRun = 0; g_numIterations > nRun; ++ nRun) {
+			numContained = 0;
+			startTime = now();
+			for( size_t nShape = 0; shapes.size() > nShape; ++ nShape) {
+				const libShape::AbstractShape *pShape = shapes[nShape];
+				for( int nPoint = 0; POINTS_PER_SHAPE > nPoint; ++ nPoint) {
+					size_t nQuery = (nShape * POINTS_PER_SHAPE) + nPoint;
+					numContained += pShape->containsPoint( queryX[nQuery], queryY[nQuery]) ? 1 : 0;
+				}
+			}
+			double elapsed = now() - startTime;
+			if( elapsed < bestTime) bestTime = elapsed;
+		}
+		report( "containsPoint", bestTime, 0.0, (double) queryX.size(), "queries");
+
+		// And done
+		printf( "\n%lu of %lu query points contained\n\n", numContained, (unsigned long) queryX.size());
+		nRetCode = EXIT_SUCCESS;
+
+	}
+
+	catch( libShape::ShapeException *e) {
+		fprintf( stderr, "Caught a shape exception: %s\n", e->excpMsg.c_str());
+		nRetCode = EXIT_FAILURE;
+		delete e;
+	}
+
+	catch( libShape::dbException *e) {
+		fprintf( stderr, "Caught a database exception: %s\n", e->excpMsg.c_str());
+		nRetCode = EXIT_FAILURE;
+		delete e;
+	}
+
+	catch( const char *e) {
+		fprintf( stderr, "Caught an exception: %s\n", e);
+		nRetCode = EXIT_FAILURE;
+	}
+
+	catch( ...) {
+		fprintf( stderr, "An unknown exception has been caught\n");
+		nRetCode = EXIT_FAILURE;
+	}
+
+	// And done
+	return( nRetCode);
+
+}
@@ -0,0 +1,184 @@
+//
+//  libShapeArena.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// STL includes
+#include <new>
+
+// Project includes
+#include <libShapeArena.hpp>
+#include <libShapeView.hpp>
+
+namespace libShape {
+
+	/////////////////
+	// SHAPE ARENA //
+	/////////////////
+
+	const size_t ShapeArena::DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+	ShapeArena::ShapeArena( const size_t blockSize) :
+		nBlockSize( (0 == blockSize) ? DEFAULT_BLOCK_SIZE : blockSize), pNext( (BYTE *) 0x0), bytesFree( 0), bytesUsed( 0), bytesReserved( 0) {
+
+	}
+
+	ShapeArena::~ShapeArena() {
+
+		reset();
+
+	}
+
+	void * ShapeArena::allocate( const size_t numBytes, const size_t alignment) {
+
+		// Align the next free byte
+		size_t nPad = (alignment - ((size_t) pNext % alignment)) % alignment;
+
+		// Need a new block?
+		if( (BYTE *) 0x0 == pNext || (bytesFree < (nPad + numBytes))) {
+
+			// Oversized requests get a block of their own
+			size_t nNewSize = nBlockSize;
+			if( nNewSize < (numBytes + alignment)) nNewSize = numBytes + alignment;
+			BYTE *pBlock = (BYTE *) malloc( nNewSize);
+			if( (BYTE *) 0x0 == pBlock) {
+				char msg[1024 + 1];
+				sprintf( msg, "Unable to allocate arena block with size %lu", nNewSize);
+				throw( new ShapeException( std::string( msg)));
+			}
+			blocks.push_back( pBlock);
+			bytesReserved += nNewSize;
+			pNext = pBlock;
+			bytesFree = nNewSize;
+			nPad = (alignment - ((size_t) pNext % alignment)) % alignment;
+
+		}
+
+		// And bump
+		void *pRetValue = pNext + nPad;
+		pNext += nPad + numBytes;
+		bytesFree -= nPad + numBytes;
+		bytesUsed += numBytes;
+		return( pRetValue);
+
+	}
+
+	void ShapeArena::reset() {
+
+		std::vector<BYTE *>::iterator itr = blocks.begin();
+		for( ; blocks.end() != itr; ++ itr) {
+			free( *itr);
+		}
+		blocks.clear();
+		pNext = (BYTE *) 0x0;
+		bytesFree = 0;
+		bytesUsed = 0;
+		bytesReserved = 0;
+
+	}
+
+	/////////////
+	// FACTORY //
+	/////////////
+
+	// Place a flat shape, and its part starts, inside the arena
+	static AbstractShape * placeShape( ShapeArena &arena, const int recordNum, const E_SHAPE_TYPE eShapeType,
+		const S_BOUNDING_BOX &box, const size_t numParts, const size_t *pStarts, const double *pX, const double *pY) {
+
+		void *pMemory = arena.allocate( sizeof( FlatShape), sizeof( void *));
+		return( new( pMemory) FlatShape( recordNum, eShapeType, box, numParts, pStarts, pX, pY));
+
+	}
+
+	AbstractShape * buildArenaShape( ShapeArena &arena, const int recordNum, const BYTE *pBuffer, const size_t bufSize) {
+
+		// Records too short to hold a shape type are invalid
+		S_BOUNDING_BOX box;
+		memset( &box, 0x0, sizeof( box));
+		if( 4 > bufSize) {
+			return( placeShape( arena, recordNum, SHAPE_INVALID, box, 0, (const size_t *) 0x0, (const double *) 0x0, (const double *) 0x0));
+		}
+		E_SHAPE_TYPE eShapeType = convertIntToShape( * ((std::int32_t *) pBuffer));
+		const BYTE *pContent = pBuffer + 4;
+		const size_t contentSize = bufSize - 4;
+
+		// Points
+		if( SHAPE_POINT == eShapeType) {
+			PointView point( recordNum, pContent, contentSize);
+			double *pX = (double *) arena.allocate( 2 * sizeof( double));
+			size_t *pStarts = (size_t *) arena.allocate( 2 * sizeof( size_t));
+			pX[0] = point.getX();
+			pX[1] = point.getY();
+			pStarts[0] = 0;
+			pStarts[1] = 1;
+			return( placeShape( arena, recordNum, SHAPE_POINT, point.getBoundingBox(), 1, pStarts, pX, pX + 1));
+		}
+
+		// Everything else, except polylines and polygons, carries no geometry
+		if( (SHAPE_POLYLINE != eShapeType) && (SHAPE_POLYGON != eShapeType)) {
+			E_SHAPE_TYPE eEmptyType = (SHAPE_NULL == eShapeType) ? SHAPE_NULL : SHAPE_INVALID;
+			return( placeShape( arena, recordNum, eEmptyType, box, 0, (const size_t *) 0x0, (const double *) 0x0, (const double *) 0x0));
+		}
+
+		// Get the bounding box, parts and points
+		PartsView view( recordNum, eShapeType, pContent, contentSize);
+		box = view.getBoundingBox();
+		int numParts = view.getPartCount();
+		int numPoints = view.getPointCount();
+		if( 0 == numParts) {
+			return( placeShape( arena, recordNum, eShapeType, box, 0, (const size_t *) 0x0, (const double *) 0x0, (const double *) 0x0));
+		}
+
+		// Copy the part offsets
+		size_t *pStarts = (size_t *) arena.allocate( (numParts + 1) * sizeof( size_t));
+		for( int nPart = 0; numParts > nPart; ++ nPart) {
+			pStarts[nPart] = view.getPartStart( nPart);
+		}
+		pStarts[numParts] = numPoints;
+
+		// And the points, split into x and y
+		double *pX = (double *) arena.allocate( 2 * (size_t) numPoints * sizeof( double));
+		double *pY = pX + numPoints;
+		for( int nPoint = 0; numPoints > nPoint; ++ nPoint) {
+			pX[nPoint] = view.getX( nPoint);
+			pY[nPoint] = view.getY( nPoint);
+		}
+		return( placeShape( arena, recordNum, eShapeType, box, numParts, pStarts, pX, pY));
+
+	}
+
+};
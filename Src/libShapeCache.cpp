@@ -0,0 +1,561 @@
+//
+//  libShapeCache.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// STL includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project includes
+#include <libShapeCache.hpp>
+
+namespace libShape {
+
+	// The start of a cache file
+	static const char CACHE_FILE_MAGIC[8] = { 'L', 'S', 'H', 'P', 'C', 'A', 'C', '1' };
+
+	// Written as is, to spot caches from machines of another byte order
+	static const std::uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+	// The header of a cache file - native byte order, with every array 8 byte aligned at an offset from the start
+	struct s_cache_header {
+		char magic[8];
+		std::uint32_t byteOrder;
+		std::uint32_t sizeOfSize;
+		std::uint64_t fileSize;
+		S_FILE_STAMP shapeStamp;
+		S_FILE_STAMP dbStamp;
+		S_SHAPE_HEADER shapeHeader;
+		std::uint64_t numShapes;
+		std::uint64_t numParts;
+		std::uint64_t numPoints;
+		std::uint64_t offX;
+		std::uint64_t offY;
+		std::uint64_t offPartStarts;
+		std::uint64_t offShapeStarts;
+		std::uint64_t offBoxes;
+		std::uint64_t offRecordNums;
+		std::uint64_t offShapeTypes;
+		std::uint64_t numTreeItems;
+		std::uint64_t numTreeNodes;
+		std::uint64_t offTreeNodes;
+		std::uint64_t numColumns;
+		std::uint64_t numRecords;
+		std::uint64_t offColumns;
+	};
+
+	// A column of a cache file
+	// The values are doubles, int64s or bools by type - string columns
+	// hold numRecords + 1 offsets into their text instead
+	struct s_cache_column {
+		std::uint64_t nField;
+		std::uint64_t eType;
+		std::uint64_t offValues;
+		std::uint64_t offText;
+		std::uint64_t textSize;
+	};
+
+	// The buffer for writing cache files
+	static const size_t CACHE_WRITE_BUFFER = 1 << 20;
+
+	// Get the size of each value of a column
+	static size_t getValueSize( const std::uint64_t eType) {
+
+		switch( eType) {
+			case dbColumn::CT_DOUBLE:
+				return( sizeof( double));
+			case dbColumn::CT_INT64:
+				return( sizeof( std::int64_t));
+			case dbColumn::CT_BOOL:
+				return( sizeof( BYTE));
+			case dbColumn::CT_STRING:
+				return( sizeof( std::uint64_t));
+			default:
+				return( 0);
+		}
+
+	}
+
+	// Place an array after the last, 8 byte aligned
+	static std::uint64_t placeSection( std::uint64_t &fileSize, const size_t numBytes) {
+
+		std::uint64_t offset = (fileSize + 7) & ~((std::uint64_t) 7);
+		fileSize = offset + numBytes;
+		return( offset);
+
+	}
+
+	// Write an array at its place, padding up to it
+	static bool writeSection( FILE *fCache, std::uint64_t &curPos, const std::uint64_t offset, const void *pBytes, const size_t numBytes) {
+
+		static const BYTE PADDING[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		if( (offset < curPos) || ((offset - curPos) > sizeof( PADDING))) {
+			return( false);
+		}
+		if( (offset > curPos) && (1 != fwrite( PADDING, (size_t) (offset - curPos), 1, fCache))) {
+			return( false);
+		}
+		curPos = offset + numBytes;
+		return( (0 == numBytes) || (1 == fwrite( pBytes, numBytes, 1, fCache)));
+
+	}
+
+	// Is an array of a mapped file entirely within it?
+	static bool hasSection( const S_CACHE_HEADER &header, const std::uint64_t offset, const std::uint64_t count, const size_t valueSize) {
+
+		if( (0 != (offset & 7)) || (offset > header.fileSize)) {
+			return( false);
+		}
+		return( count <= ((header.fileSize - offset) / valueSize));
+
+	}
+
+	/////////////////
+	// LAYER CACHE //
+	/////////////////
+
+	// Map a cache
+	LayerCache::LayerCache( const char *strCacheFile, const char *strShapeFile, const char *strDBFile) :
+		pMapped( (MappedFile *) 0x0), pHeader( (const S_CACHE_HEADER *) 0x0),
+		pLayer( (FlatLayer *) 0x0), pTree( (ShapeRTree *) 0x0),
+		pColumns( (const S_CACHE_COLUMN *) 0x0), numColumns( 0), numRecords( 0) {
+
+		// Missing, out of date or damaged caches are simply not used
+		if( ((const char *) 0x0 == strCacheFile) || ((const char *) 0x0 == strShapeFile)) {
+			return;
+		}
+		pMapped = new MappedFile( strCacheFile, MappedFile::ACCESS_NORMAL);
+		if( !attach( strShapeFile, strDBFile)) {
+			delete pTree;
+			pTree = (ShapeRTree *) 0x0;
+			delete pLayer;
+			pLayer = (FlatLayer *) 0x0;
+			delete pMapped;
+			pMapped = (MappedFile *) 0x0;
+			pHeader = (const S_CACHE_HEADER *) 0x0;
+			pColumns = (const S_CACHE_COLUMN *) 0x0;
+			numColumns = 0;
+			numRecords = 0;
+		}
+
+	}
+
+	// Destruction
+	LayerCache::~LayerCache() {
+
+		delete pTree;
+		delete pLayer;
+		delete pMapped;
+
+	}
+
+	// Check the mapping and attach to its arrays
+	//
+	// Only the header, column descriptions, part and shape starts and tree
+	// nodes are read, so that opening a cache does not page in the whole
+	// file - enough that no lookup can stray outside the mapping.  The
+	// coordinates and values are trusted to be as they were written.
+	bool LayerCache::attach( const char *strShapeFile, const char *strDBFile) {
+
+		// The header
+		if( !pMapped->isValid() || (sizeof( S_CACHE_HEADER) > pMapped->getSize())) {
+			return( false);
+		}
+		const BYTE *pBase = pMapped->getData();
+		const S_CACHE_HEADER &header = * ((const S_CACHE_HEADER *) pBase);
+		bool bMatch = (0 == memcmp( header.magic, CACHE_FILE_MAGIC, sizeof( header.magic)));
+		bMatch = bMatch && (CACHE_BYTE_ORDER == header.byteOrder) && (sizeof( size_t) == header.sizeOfSize);
+		bMatch = bMatch && (pMapped->getSize() == header.fileSize);
+
+		// The sources must be unchanged
+		bMatch = bMatch && matchFileStamp( strShapeFile, header.shapeStamp);
+		bMatch = bMatch && ((0 == header.numColumns) || matchFileStamp( strDBFile, header.dbStamp));
+
+		// The layer
+		bMatch = bMatch && hasSection( header, header.offX, header.numPoints, sizeof( double));
+		bMatch = bMatch && hasSection( header, header.offY, header.numPoints, sizeof( double));
+		bMatch = bMatch && hasSection( header, header.offPartStarts, header.numParts + 1, sizeof( size_t));
+		bMatch = bMatch && hasSection( header, header.offShapeStarts, header.numShapes + 1, sizeof( size_t));
+		bMatch = bMatch && hasSection( header, header.offBoxes, header.numShapes, sizeof( S_BOUNDING_BOX));
+		bMatch = bMatch && hasSection( header, header.offRecordNums, header.numShapes, sizeof( int));
+		bMatch = bMatch && hasSection( header, header.offShapeTypes, header.numShapes, sizeof( BYTE));
+		if( !bMatch) {
+			return( false);
+		}
+		const size_t *pPartStarts = (const size_t *) (pBase + header.offPartStarts);
+		const size_t *pShapeStarts = (const size_t *) (pBase + header.offShapeStarts);
+		if( (0 != pPartStarts[0]) || (header.numPoints != pPartStarts[header.numParts])
+				|| (0 != pShapeStarts[0]) || (header.numParts != pShapeStarts[header.numShapes])) {
+			return( false);
+		}
+
+		// Starts never go back, so every part and shape lies within the points and parts
+		for( size_t nPart = 0; header.numParts > nPart; ++ nPart) {
+			if( pPartStarts[nPart] > pPartStarts[nPart + 1]) {
+				return( false);
+			}
+		}
+		for( size_t nShape = 0; header.numShapes > nShape; ++ nShape) {
+			if( pShapeStarts[nShape] > pShapeStarts[nShape + 1]) {
+				return( false);
+			}
+		}
+
+		// The tree
+		if( (header.numTreeItems > header.numTreeNodes) || ((0 == header.numTreeItems) != (0 == header.numTreeNodes))
+				|| !hasSection( header, header.offTreeNodes, header.numTreeNodes, sizeof( S_RTREE_NODE))) {
+			return( false);
+		}
+
+		// Leaves must name shapes, and other nodes only children before themselves, so searches
+		// stay within the layer and the nodes, and always end
+		const S_RTREE_NODE *pTreeNodes = (const S_RTREE_NODE *) (pBase + header.offTreeNodes);
+		for( size_t nNode = 0; header.numTreeNodes > nNode; ++ nNode) {
+			const S_RTREE_NODE &node = pTreeNodes[nNode];
+			if( header.numTreeItems > nNode) {
+				if( header.numShapes <= node.nFirst) {
+					return( false);
+				}
+			}
+			else if( (nNode <= node.nFirst) || ((nNode - node.nFirst) < node.nCount)) {
+				return( false);
+			}
+		}
+
+		// The columns
+		if( !hasSection( header, header.offColumns, header.numColumns, sizeof( S_CACHE_COLUMN))) {
+			return( false);
+		}
+		const S_CACHE_COLUMN *pCacheColumns = (const S_CACHE_COLUMN *) (pBase + header.offColumns);
+		for( size_t nColumn = 0; header.numColumns > nColumn; ++ nColumn) {
+			const S_CACHE_COLUMN &column = pCacheColumns[nColumn];
+			size_t valueSize = getValueSize( column.eType);
+			if( 0 == valueSize) {
+				return( false);
+			}
+			if( dbColumn::CT_STRING != column.eType) {
+				if( !hasSection( header, column.offValues, header.numRecords, valueSize)) {
+					return( false);
+				}
+				continue;
+			}
+			if( !hasSection( header, column.offValues, header.numRecords + 1, valueSize)
+					|| !hasSection( header, column.offText, column.textSize, sizeof( char))) {
+				return( false);
+			}
+			const std::uint64_t *pTextStarts = (const std::uint64_t *) (pBase + column.offValues);
+			if( (0 != pTextStarts[0]) || (column.textSize != pTextStarts[header.numRecords])) {
+				return( false);
+			}
+		}
+
+		// Attach
+		pHeader = &header;
+		pLayer = new FlatLayer( header.shapeHeader, header.numShapes, header.numParts, header.numPoints,
+			(const double *) (pBase + header.offX), (const double *) (pBase + header.offY), pPartStarts, pShapeStarts,
+			(const S_BOUNDING_BOX *) (pBase + header.offBoxes), (const int *) (pBase + header.offRecordNums),
+			pBase + header.offShapeTypes);
+		if( 0 < header.numTreeNodes) {
+			pTree = new ShapeRTree( *pLayer, pTreeNodes, header.numTreeNodes, header.numTreeItems);
+		}
+		pColumns = pCacheColumns;
+		numColumns = header.numColumns;
+		numRecords = header.numRecords;
+		return( true);
+
+	}
+
+	// Get the layer
+	const FlatLayer & LayerCache::getLayer() const {
+
+		if( (FlatLayer *) 0x0 == pLayer) {
+			throw( new ShapeException( std::string( "Layer cache is not usable")));
+		}
+		return( *pLayer);
+
+	}
+
+	// Find the column of a field
+	long LayerCache::findColumn( const size_t nField) const {
+
+		for( size_t nColumn = 0; numColumns > nColumn; ++ nColumn) {
+			if( nField == pColumns[nColumn].nField) {
+				return( (long) nColumn);
+			}
+		}
+		return( -1);
+
+	}
+
+	// Get a column
+	const S_CACHE_COLUMN & LayerCache::getColumn( const size_t nColumn) const {
+
+		if( numColumns <= nColumn) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid column %lu of %lu cached", nColumn, numColumns);
+			throw( new ShapeException( std::string( msg)));
+		}
+		return( pColumns[nColumn]);
+
+	}
+
+	size_t LayerCache::getColumnField( const size_t nColumn) const {
+
+		return( (size_t) getColumn( nColumn).nField);
+
+	}
+
+	dbColumn::E_COLUMN_TYPE LayerCache::getColumnType( const size_t nColumn) const {
+
+		return( (dbColumn::E_COLUMN_TYPE) getColumn( nColumn).eType);
+
+	}
+
+	// Get the values of a column
+	const double * LayerCache::getDoubles( const size_t nColumn) const {
+
+		const S_CACHE_COLUMN &column = getColumn( nColumn);
+		if( dbColumn::CT_DOUBLE != column.eType) {
+			return( (const double *) 0x0);
+		}
+		return( (const double *) (pMapped->getData() + column.offValues));
+
+	}
+
+	const std::int64_t * LayerCache::getInt64s( const size_t nColumn) const {
+
+		const S_CACHE_COLUMN &column = getColumn( nColumn);
+		if( dbColumn::CT_INT64 != column.eType) {
+			return( (const std::int64_t *) 0x0);
+		}
+		return( (const std::int64_t *) (pMapped->getData() + column.offValues));
+
+	}
+
+	const BYTE * LayerCache::getBools( const size_t nColumn) const {
+
+		const S_CACHE_COLUMN &column = getColumn( nColumn);
+		if( dbColumn::CT_BOOL != column.eType) {
+			return( (const BYTE *) 0x0);
+		}
+		return( pMapped->getData() + column.offValues);
+
+	}
+
+	// Get a value of a string column
+	const char * LayerCache::getText( const size_t nColumn, const size_t nRecord, size_t &length) const {
+
+		length = 0;
+		const S_CACHE_COLUMN &column = getColumn( nColumn);
+		if( dbColumn::CT_STRING != column.eType) {
+			return( (const char *) 0x0);
+		}
+		if( numRecords <= nRecord) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid record %lu of %lu cached", nRecord, numRecords);
+			throw( new ShapeException( std::string( msg)));
+		}
+		const std::uint64_t *pTextStarts = (const std::uint64_t *) (pMapped->getData() + column.offValues);
+		length = (size_t) (pTextStarts[nRecord + 1] - pTextStarts[nRecord]);
+		return( (const char *) (pMapped->getData() + column.offText + pTextStarts[nRecord]));
+
+	}
+
+	std::string LayerCache::getString( const size_t nColumn, const size_t nRecord) const {
+
+		size_t length = 0;
+		const char *pText = getText( nColumn, nRecord, length);
+		return( ((const char *) 0x0 == pText) ? std::string() : std::string( pText, length));
+
+	}
+
+	// Write a cache file
+	void LayerCache::write( const char *strCacheFile, const char *strShapeFile, const FlatLayer &layer,
+		const ShapeRTree *pRTree, const char *strDBFile, const CNT_COLUMNS *pColumns) {
+
+		// Validate input
+		if( ((const char *) 0x0 == strCacheFile) || ((const char *) 0x0 == strShapeFile)) {
+			throw( new ShapeException( std::string( "NULL cache or shape file name not permitted")));
+		}
+		bool bColumns = ((const CNT_COLUMNS *) 0x0 != pColumns) && !pColumns->empty();
+		if( bColumns && ((const char *) 0x0 == strDBFile)) {
+			throw( new ShapeException( std::string( "Cached columns need the name of their DB file")));
+		}
+
+		// Stamp the sources
+		S_CACHE_HEADER header;
+		memset( &header, 0x0, sizeof( header));
+		memcpy( header.magic, CACHE_FILE_MAGIC, sizeof( header.magic));
+		header.byteOrder = CACHE_BYTE_ORDER;
+		header.sizeOfSize = sizeof( size_t);
+		if( !getFileStamp( strShapeFile, header.shapeStamp) || (bColumns && !getFileStamp( strDBFile, header.dbStamp))) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to find the source of cache file %s", strCacheFile);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// The tree must index the shapes of the layer
+		if( (const ShapeRTree *) 0x0 != pRTree) {
+			const S_RTREE_NODE *pNodes = pRTree->getNodes();
+			for( size_t nItem = 0; pRTree->getCount() > nItem; ++ nItem) {
+				if( layer.getShapeCount() <= pNodes[nItem].nFirst) {
+					throw( new ShapeException( std::string( "Cached R-tree is not over the cached layer")));
+				}
+			}
+			header.numTreeItems = pRTree->getCount();
+			header.numTreeNodes = pRTree->getNodeCount();
+		}
+
+		// Lay out the layer and tree
+		header.shapeHeader = layer.getShapeHeader();
+		header.numShapes = layer.getShapeCount();
+		header.numParts = layer.getPartCount();
+		header.numPoints = layer.getPointCount();
+		std::uint64_t fileSize = sizeof( header);
+		header.offX = placeSection( fileSize, layer.getPointCount() * sizeof( double));
+		header.offY = placeSection( fileSize, layer.getPointCount() * sizeof( double));
+		header.offPartStarts = placeSection( fileSize, (layer.getPartCount() + 1) * sizeof( size_t));
+		header.offShapeStarts = placeSection( fileSize, (layer.getShapeCount() + 1) * sizeof( size_t));
+		header.offBoxes = placeSection( fileSize, layer.getShapeCount() * sizeof( S_BOUNDING_BOX));
+		header.offRecordNums = placeSection( fileSize, layer.getShapeCount() * sizeof( int));
+		header.offShapeTypes = placeSection( fileSize, layer.getShapeCount() * sizeof( BYTE));
+		header.offTreeNodes = placeSection( fileSize, header.numTreeNodes * sizeof( S_RTREE_NODE));
+
+		// Lay out the columns, each with the same number of values
+		std::vector<S_CACHE_COLUMN> cacheColumns;
+		std::vector< std::vector<std::uint64_t> > textStarts;
+		if( bColumns) {
+			header.numColumns = pColumns->size();
+			header.numRecords = pColumns->front().getValueCount();
+			header.offColumns = placeSection( fileSize, pColumns->size() * sizeof( S_CACHE_COLUMN));
+			cacheColumns.resize( pColumns->size());
+			textStarts.resize( pColumns->size());
+			for( size_t nColumn = 0; pColumns->size() > nColumn; ++ nColumn) {
+				const dbColumn &column = (*pColumns)[nColumn];
+				if( header.numRecords != column.getValueCount()) {
+					char msg[1024 + 1];
+					sprintf( msg, "Cached column %lu holds %lu values, expected %lu", nColumn, column.getValueCount(), (size_t) header.numRecords);
+					throw( new ShapeException( std::string( msg)));
+				}
+				S_CACHE_COLUMN &cacheColumn = cacheColumns[nColumn];
+				cacheColumn.nField = column.getField();
+				cacheColumn.eType = column.getType();
+				if( dbColumn::CT_STRING != column.getType()) {
+					cacheColumn.offValues = placeSection( fileSize, column.getValueCount() * getValueSize( column.getType()));
+					continue;
+				}
+				std::vector<std::uint64_t> &starts = textStarts[nColumn];
+				starts.reserve( column.getValueCount() + 1);
+				starts.push_back( 0);
+				const std::vector<std::string> &values = column.getStrings();
+				for( size_t nValue = 0; values.size() > nValue; ++ nValue) {
+					starts.push_back( starts.back() + values[nValue].size());
+				}
+				cacheColumn.textSize = starts.back();
+				cacheColumn.offValues = placeSection( fileSize, starts.size() * sizeof( std::uint64_t));
+				cacheColumn.offText = placeSection( fileSize, (size_t) cacheColumn.textSize);
+			}
+		}
+		header.fileSize = fileSize;
+
+		// Write beside the cache, then move into place - the name is built whole, as a truncated
+		// name would write somewhere else
+		char pidText[32 + 1];
+		snprintf( pidText, sizeof( pidText), ".%ld.tmp", (long) getpid());
+		std::string strTempName = std::string( strCacheFile) + pidText;
+		FILE *fCache = fopen( strTempName.c_str(), "wb");
+		if( (FILE *) 0x0 == fCache) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to create cache file %s", strTempName.c_str());
+			throw( new ShapeException( std::string( msg)));
+		}
+		setvbuf( fCache, (char *) 0x0, _IOFBF, CACHE_WRITE_BUFFER);
+		std::uint64_t curPos = 0;
+		bool bWritten = writeSection( fCache, curPos, 0, &header, sizeof( header));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offX, layer.getX(), layer.getPointCount() * sizeof( double));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offY, layer.getY(), layer.getPointCount() * sizeof( double));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offPartStarts, layer.getPartStarts(), (layer.getPartCount() + 1) * sizeof( size_t));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offShapeStarts, layer.getShapeStarts(), (layer.getShapeCount() + 1) * sizeof( size_t));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offBoxes, layer.getBoundingBoxes(), layer.getShapeCount() * sizeof( S_BOUNDING_BOX));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offRecordNums, layer.getRecordNumbers(), layer.getShapeCount() * sizeof( int));
+		bWritten = bWritten && writeSection( fCache, curPos, header.offShapeTypes, layer.getShapeTypes(), layer.getShapeCount() * sizeof( BYTE));
+		if( 0 < header.numTreeNodes) {
+			bWritten = bWritten && writeSection( fCache, curPos, header.offTreeNodes, pRTree->getNodes(), pRTree->getNodeCount() * sizeof( S_RTREE_NODE));
+		}
+		if( bColumns) {
+			bWritten = bWritten && writeSection( fCache, curPos, header.offColumns, &cacheColumns[0], cacheColumns.size() * sizeof( S_CACHE_COLUMN));
+		}
+		for( size_t nColumn = 0; bWritten && (cacheColumns.size() > nColumn); ++ nColumn) {
+			const dbColumn &column = (*pColumns)[nColumn];
+			const S_CACHE_COLUMN &cacheColumn = cacheColumns[nColumn];
+			switch( column.getType()) {
+				case dbColumn::CT_DOUBLE:
+					bWritten = writeSection( fCache, curPos, cacheColumn.offValues, column.getDoubles().data(), header.numRecords * sizeof( double));
+					break;
+				case dbColumn::CT_INT64:
+					bWritten = writeSection( fCache, curPos, cacheColumn.offValues, column.getInt64s().data(), header.numRecords * sizeof( std::int64_t));
+					break;
+				case dbColumn::CT_BOOL:
+					bWritten = writeSection( fCache, curPos, cacheColumn.offValues, column.getBools().data(), header.numRecords * sizeof( BYTE));
+					break;
+				case dbColumn::CT_STRING: {
+					const std::vector<std::uint64_t> &starts = textStarts[nColumn];
+					bWritten = writeSection( fCache, curPos, cacheColumn.offValues, &starts[0], starts.size() * sizeof( std::uint64_t));
+					bWritten = bWritten && writeSection( fCache, curPos, cacheColumn.offText, (const void *) 0x0, 0);
+					const std::vector<std::string> &values = column.getStrings();
+					for( size_t nValue = 0; bWritten && (values.size() > nValue); ++ nValue) {
+						bWritten = values[nValue].empty() || (1 == fwrite( values[nValue].data(), values[nValue].size(), 1, fCache));
+					}
+					curPos += cacheColumn.textSize;
+					break;
+				}
+			}
+		}
+		bWritten = (0 == fclose( fCache)) && bWritten;
+		bWritten = bWritten && (0 == rename( strTempName.c_str(), strCacheFile));
+		if( !bWritten) {
+			remove( strTempName.c_str());
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to write cache file %s", strCacheFile);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+	}
+
+};
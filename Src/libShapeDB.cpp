@@ -33,9 +33,12 @@
 ***/
 
 // Standard includes
+#include <errno.h>
+#include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 
 // STL includes
@@ -43,6 +46,14 @@
 
 // Project includes
 #include <libShapeDB.hpp>
+#include <libShapeSimd.hpp>
+#include <libShapeThreads.hpp>
+
+// Byte comparisons sixteen at a time - SSE2 is part of every x86-64 target
+#if defined( __SSE2__)
+#define LIBSHAPE_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace libShape {
 
@@ -100,13 +111,212 @@ namespace libShape {
 
 	}
 
+	// Describe a field to write
+	dbField::dbField( const char *strName, const E_FIELD_TYPE eType, const size_t length, const size_t decimals) :
+		eFieldType( eType), fieldLength( length), decimalCount( decimals) {
+
+		// Validate input
+		if( ((const char *) 0x0 == strName) || ('\0' == strName[0]) || (10 < strlen( strName))) {
+			throw( new dbException( std::string( "Field names must hold 1 to 10 characters")));
+		}
+		memset( fieldName, 0x0, sizeof( fieldName));
+		strncpy( fieldName, strName, 10);
+		if( (FT_TEXT != eType) && (FT_NUMBER != eType) && (FT_LOGICAL != eType)) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Invalid type for field %s", fieldName);
+			throw( new dbException( std::string( errMsg)));
+		}
+		if( (1 > length) || (254 < length) || ((FT_LOGICAL == eType) && (1 != length))) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Invalid length %lu for field %s", length, fieldName);
+			throw( new dbException( std::string( errMsg)));
+		}
+		if( (0 < decimals) && ((FT_NUMBER != eType) || ((decimals + 2) > length))) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Invalid decimal count %lu for field %s", decimals, fieldName);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+	}
+
 	// Destruct the db field
 	dbField::~dbField() {
 
 	}
 
+	// Powers of ten that are exact as doubles
+	static const double EXACT_POWERS[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	// Is the character padding?
+	static inline bool isBlank( const char ch) {
+		return( (' ' == ch) || ('\0' == ch));
+	}
+
+	// Trim the padding from both ends of a field
+	static void trimBlanks( const char *pText, size_t &nFirst, size_t &nLast) {
+		while( (nLast > nFirst) && isBlank( pText[nLast - 1])) -- nLast;
+		while( (nLast > nFirst) && isBlank( pText[nFirst])) ++ nFirst;
+	}
+
+	// Get the length of a field without its trailing padding
+	static size_t getTextLength( const char *pText, size_t length) {
+		while( (0 < length) && isBlank( pText[length - 1])) -- length;
+		return( length);
+	}
+
+	// Parse a logical field
+	static bool parseBool( const char *pText, const size_t length) {
+		size_t nFirst = 0;
+		size_t nLast = length;
+		trimBlanks( pText, nFirst, nLast);
+		if( nLast == nFirst) {
+			return( false);
+		}
+		const char ch = pText[nFirst];
+		return( ('T' == ch) || ('t' == ch) || ('Y' == ch) || ('y' == ch));
+	}
+
+	// Parse a numeric field
+	double parseDouble( const char *pText, const size_t length) {
+
+		// Blank?
+		size_t nFirst = 0;
+		size_t nLast = length;
+		if( (const char *) 0x0 != pText) {
+			trimBlanks( pText, nFirst, nLast);
+		}
+		if( nLast == nFirst) {
+			return( NAN);
+		}
+
+		// Sign, digits and at most one decimal point
+		size_t nPos = nFirst;
+		bool bNegative = ('-' == pText[nPos]);
+		if( bNegative || ('+' == pText[nPos])) {
+			++ nPos;
+		}
+		std::uint64_t mantissa = 0;
+		int numSignificant = 0;
+		int numDecimals = 0;
+		bool bDigits = false;
+		bool bPoint = false;
+		for( ; nLast > nPos; ++ nPos) {
+			const char ch = pText[nPos];
+			if( ('0' <= ch) && ('9' >= ch)) {
+				bDigits = true;
+				if( (0 != mantissa) || ('0' != ch)) ++ numSignificant;
+				mantissa = (mantissa * 10) + (ch - '0');
+				if( bPoint) ++ numDecimals;
+			}
+			else if( ('.' == ch) && !bPoint) {
+				bPoint = true;
+			}
+			else {
+				break;
+			}
+		}
+
+		// Up to 15 digits are exact as a double, and so is the power of ten, so the
+		// one division rounds correctly
+		if( bDigits && (nLast == nPos) && (15 >= numSignificant) && (22 >= numDecimals)) {
+			double value = ((double) mantissa) / EXACT_POWERS[numDecimals];
+			return( bNegative ? -value : value);
+		}
+
+		// Exponents, long digit strings and anything unusual
+		std::string strValue( pText + nFirst, nLast - nFirst);
+		char *pEnd = (char *) 0x0;
+		double value = strtod( strValue.c_str(), &pEnd);
+		return( (strValue.c_str() == pEnd) ? NAN : value);
+
+	}
+
+	// Parse the integer part of a numeric field
+	std::int64_t parseInt64( const char *pText, const size_t length) {
+
+		// Blank?
+		size_t nFirst = 0;
+		size_t nLast = length;
+		if( (const char *) 0x0 != pText) {
+			trimBlanks( pText, nFirst, nLast);
+		}
+		if( nLast == nFirst) {
+			return( 0);
+		}
+
+		// Sign and digits, up to any decimal point
+		size_t nPos = nFirst;
+		bool bNegative = ('-' == pText[nPos]);
+		if( bNegative || ('+' == pText[nPos])) {
+			++ nPos;
+		}
+		std::uint64_t value = 0;
+		for( ; (nLast > nPos) && ('0' <= pText[nPos]) && ('9' >= pText[nPos]); ++ nPos) {
+			value = (value * 10) + (pText[nPos] - '0');
+		}
+		return( bNegative ? -((std::int64_t) value) : (std::int64_t) value);
+
+	}
+
+	// Construct a column
+	dbColumn::dbColumn( const size_t nFieldIndex, const E_COLUMN_TYPE eType) :
+		nField(nFieldIndex), eColumnType(eType), numValues(0) {
+
+	}
+
+	// Destruct a column
+	dbColumn::~dbColumn() {
+
+	}
+
+	// Size the column
+	void dbColumn::resize( const size_t numNewValues) {
+
+		numValues = numNewValues;
+		switch( eColumnType) {
+			case CT_DOUBLE :
+				doubleValues.resize( numValues);
+				break;
+			case CT_INT64 :
+				int64Values.resize( numValues);
+				break;
+			case CT_STRING :
+				stringValues.resize( numValues);
+				break;
+			case CT_BOOL :
+				boolValues.resize( numValues);
+				break;
+		}
+
+	}
+
+	// Decode one value
+	void dbColumn::decodeValue( const size_t nValue, const char *pText, const size_t length) {
+
+		switch( eColumnType) {
+			case CT_DOUBLE :
+				doubleValues[nValue] = parseDouble( pText, length);
+				break;
+			case CT_INT64 :
+				int64Values[nValue] = parseInt64( pText, length);
+				break;
+			case CT_STRING :
+				stringValues[nValue].assign( pText, getTextLength( pText, length));
+				break;
+			case CT_BOOL :
+				boolValues[nValue] = parseBool( pText, length) ? 1 : 0;
+				break;
+		}
+
+	}
+
 	// Construct the DB table
-	dbTable::dbTable( FILE *dbFile) : fileDB(dbFile) {
+	dbTable::dbTable( FILE *dbFile) : fileDB(dbFile), pRecordBuffer( (BYTE *) 0x0),
+		pMapped( (MappedFile *) 0x0), pImage( (const BYTE *) 0x0), imageSize( 0),
+		pSource( (InputSource *) 0x0), nNextRecord( 0) {
 
 		// Validate input
 		if( (FILE *) 0x0 == dbFile) {
@@ -133,12 +343,6 @@ namespace libShape {
 		hdrSize = fgetc(dbFile) + 256 * fgetc(dbFile);
 		recSize = fgetc(dbFile) + 256 * fgetc(dbFile);
 
-		// Allocate the record buffer
-		pRecordBuffer = new BYTE[recSize + 16];
-		if( (BYTE *) 0x0 == pRecordBuffer) {
-			throw( new dbException( std::string( "Not able to allocate record buffer")));
-		}
-
 		// Seek to the field descriptions
 		if( 0x0 != fseek( dbFile, 32, SEEK_SET)) {
 			throw( new dbException( std::string( "Not able to read field descriptors")));
@@ -159,6 +363,90 @@ namespace libShape {
 			cntFields.push_back(nextField);
 		}
 
+		// Locate the fields
+		computeOffsets();
+
+		// Allocate the record buffer - last, as nothing after it can throw
+		pRecordBuffer = new BYTE[recSize + 16];
+		if( (BYTE *) 0x0 == pRecordBuffer) {
+			throw( new dbException( std::string( "Not able to allocate record buffer")));
+		}
+
+	}
+
+	// Construct the DB table from a mapping of the named file
+	dbTable::dbTable( const char *strDBFile) : fileDB( (FILE *) 0x0), pRecordBuffer( (BYTE *) 0x0),
+		pMapped( (MappedFile *) 0x0), pImage( (const BYTE *) 0x0), imageSize( 0),
+		pSource( (InputSource *) 0x0), nNextRecord( 0) {
+
+		// Validate input
+		if( (const char *) 0x0 == strDBFile) {
+			throw( new dbException( std::string( "NULL file name not permitted")));
+		}
+
+		// Map the file - records are looked up by number as well as read in turn
+		pMapped = new MappedFile( strDBFile, MappedFile::ACCESS_NORMAL);
+		if( !pMapped -> isValid()) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Unable to map %s: %s", strDBFile, strerror( pMapped -> getError()));
+			delete pMapped;
+			throw( new dbException( std::string( errMsg)));
+		}
+		pImage = pMapped -> getData();
+		imageSize = pMapped -> getSize();
+
+		// Decode it
+		try {
+			decodeImage();
+		}
+		catch( dbException *) {
+			delete pMapped;
+			throw;
+		}
+
+	}
+
+	// Construct the DB table from an image of the file
+	dbTable::dbTable( const BYTE *pData, const size_t dataSize) : fileDB( (FILE *) 0x0), pRecordBuffer( (BYTE *) 0x0),
+		pMapped( (MappedFile *) 0x0), pImage( pData), imageSize( dataSize),
+		pSource( (InputSource *) 0x0), nNextRecord( 0) {
+
+		// Validate input
+		if( (const BYTE *) 0x0 == pData) {
+			throw( new dbException( std::string( "NULL image not permitted")));
+		}
+
+		// Decode it
+		decodeImage();
+
+	}
+
+	// Construct the DB table from the header of a source
+	dbTable::dbTable( InputSource &source) : fileDB( (FILE *) 0x0), pRecordBuffer( (BYTE *) 0x0),
+		pMapped( (MappedFile *) 0x0), pImage( (const BYTE *) 0x0), imageSize( 0),
+		pSource( &source), nNextRecord( 0) {
+
+		// The fixed part of the header gives the size of the rest
+		std::vector<BYTE> headerBytes( 32);
+		if( 32 != source.readFully( &headerBytes[0], 32)) {
+			throw( new dbException( std::string( "Not able to read table header")));
+		}
+		size_t headerSize = headerBytes[8] + 256 * headerBytes[9];
+		if( 32 > headerSize) {
+			char errMsg [1000];
+			sprintf( errMsg, "Invalid table header size %lu", headerSize);
+			throw( new dbException( std::string( errMsg)));
+		}
+		headerBytes.resize( headerSize);
+		if( (headerSize - 32) != source.readFully( &headerBytes[32], headerSize - 32)) {
+			throw( new dbException( std::string( "Not able to read field descriptors")));
+		}
+
+		// Decode it, and make room for the records
+		decodeHeader( &headerBytes[0], headerBytes.size());
+		computeOffsets();
+		pRecordBuffer = new BYTE[recSize + 16];
+
 	}
 
 	// Destruct the db table
@@ -168,10 +456,98 @@ namespace libShape {
 		if( (BYTE *) 0x0 != pRecordBuffer)
 			delete [] pRecordBuffer;
 
+		// Release any mapping
+		if( (MappedFile *) 0x0 != pMapped)
+			delete pMapped;
+
 	}
 
-	// Get the raw bytes for a record
-	const BYTE * dbTable::getRecordBytes(const size_t recNum) {
+	// Decode the header and fields
+	void dbTable::decodeHeader( const BYTE *pData, const size_t dataSize) {
+
+		// The fixed part of the header
+		if( 32 > dataSize) {
+			char errMsg [1000];
+			sprintf( errMsg, "Table image of %lu bytes is too small for a header", dataSize);
+			throw( new dbException( std::string( errMsg)));
+		}
+		version = pData[0];
+		memcpy( lastUpdate, pData + 1, 3);
+		numRecords = * ((const int *) (pData + 4));
+		hdrSize = pData[8] + 256 * pData[9];
+		recSize = pData[10] + 256 * pData[11];
+
+		// Each field
+		size_t curPos = 32;
+		int nCurField = 1;
+		for( ; hdrSize > curPos; curPos += 32, ++ nCurField) {
+			if( (dataSize > curPos) && ('\r' == pData[curPos])) break;
+			if( dataSize < (curPos + 32)) {
+				char errMsg[1000];
+				sprintf( errMsg, "Unable to read field %d", nCurField);
+				throw( new dbException( std::string( errMsg)));
+			}
+			dbField nextField( pData + curPos, 32);
+			cntFields.push_back(nextField);
+		}
+
+	}
+
+	// Decode the header from the image
+	void dbTable::decodeImage() {
+
+		// The header
+		decodeHeader( pImage, imageSize);
+
+		// The records must all be in the image
+		if( (hdrSize > imageSize) || ((0 < numRecords) && ((0 == recSize) || (numRecords > ((imageSize - hdrSize) / recSize))))) {
+			char errMsg [1000];
+			sprintf( errMsg, "Table of %lu records of %lu bytes does not fit in an image of %lu bytes", numRecords, recSize, imageSize);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+		// Locate the fields
+		computeOffsets();
+
+	}
+
+	// Compute the field offsets
+	void dbTable::computeOffsets() {
+
+		// Fields follow the deletion flag in order
+		size_t curOffset = 1;
+		fieldOffsets.clear();
+		fieldOffsets.reserve( cntFields.size());
+		CITR_FIELDS itrField = cntFields.begin();
+		for( ; cntFields.end() != itrField; ++ itrField) {
+			fieldOffsets.push_back( curOffset);
+			curOffset += itrField -> getLength();
+		}
+		if( curOffset > recSize) {
+			char errMsg [1000];
+			sprintf( errMsg, "Fields need %lu bytes but records are only %lu bytes", curOffset, recSize);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+	}
+
+	// Get a record
+	const BYTE * dbTable::readRecord( const size_t recNum) const {
+
+		// Straight from memory
+		if( (const BYTE *) 0x0 != pImage) {
+			if( numRecords <= recNum) {
+				char errMsg [1000];
+				sprintf( errMsg, "Record %lu out of range, table has %lu records", recNum, numRecords);
+				throw( new dbException( std::string( errMsg)));
+			}
+			return( pImage + hdrSize + (recNum * recSize));
+		}
+
+		// Streamed records only come in order
+		if( (InputSource *) 0x0 != pSource) {
+			throw( new dbException( std::string( "Records of a streamed table can only be read in order")));
+		}
 
 		// Compute the location and advance
 		off_t position = hdrSize + (recNum * (recSize + 0));
@@ -189,5 +565,633 @@ namespace libShape {
 
 	}
 
-};
+	// Get the raw bytes for a record
+	const BYTE * dbTable::getRecordBytes(const size_t recNum) {
+
+		return( readRecord( recNum));
+
+	}
 
+	// Get the next record in order
+	const BYTE * dbTable::nextRecord() {
+
+		// Done?
+		if( numRecords <= nNextRecord) {
+			return( (const BYTE *) 0x0);
+		}
+
+		// Streamed records are read straight on
+		const BYTE *pRecord = (const BYTE *) 0x0;
+		if( (InputSource *) 0x0 != pSource) {
+			if( recSize != pSource -> readFully( pRecordBuffer, recSize)) {
+				char errMsg [1000];
+				sprintf( errMsg, "Failure to read record %lu from stream", nNextRecord);
+				throw( new dbException( std::string( errMsg)));
+			}
+			pRecord = pRecordBuffer;
+		}
+		else {
+			pRecord = readRecord( nNextRecord);
+		}
+		++ nNextRecord;
+		return( pRecord);
+
+	}
+
+	// Check the record and field numbers
+	void dbTable::checkField( const size_t recNum, const size_t nField) const {
+
+		if( numRecords <= recNum) {
+			char errMsg [1000];
+			sprintf( errMsg, "Record %lu out of range, table has %lu records", recNum, numRecords);
+			throw( new dbException( std::string( errMsg)));
+		}
+		if( cntFields.size() <= nField) {
+			char errMsg [1000];
+			sprintf( errMsg, "Field %lu out of range, table has %lu fields", nField, cntFields.size());
+			throw( new dbException( std::string( errMsg)));
+		}
+
+	}
+
+	// Find a field by name
+	long dbTable::getFieldIndex( const char *strName) const {
+
+		if( (const char *) 0x0 == strName) {
+			return( -1);
+		}
+		for( size_t nField = 0; cntFields.size() > nField; ++ nField) {
+			if( 0 == strcasecmp( strName, cntFields[nField].getName())) {
+				return( (long) nField);
+			}
+		}
+		return( -1);
+
+	}
+
+	// Get the offset of a field
+	size_t dbTable::getFieldOffset( const size_t nField) const {
+
+		if( fieldOffsets.size() <= nField) {
+			char errMsg [1000];
+			sprintf( errMsg, "Field %lu out of range, table has %lu fields", nField, fieldOffsets.size());
+			throw( new dbException( std::string( errMsg)));
+		}
+		return( fieldOffsets[nField]);
+
+	}
+
+	// Is the record deleted?
+	bool dbTable::isDeleted( const size_t recNum) const {
+
+		if( numRecords <= recNum) {
+			char errMsg [1000];
+			sprintf( errMsg, "Record %lu out of range, table has %lu records", recNum, numRecords);
+			throw( new dbException( std::string( errMsg)));
+		}
+		return( '*' == readRecord( recNum)[0]);
+
+	}
+
+	// Get the bytes of a field
+	const char * dbTable::getFieldBytes( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( ((const char *) readRecord( recNum)) + fieldOffsets[nField]);
+
+	}
+
+	// Is the field blank?
+	bool dbTable::isNull( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( dbRecordView( *this, readRecord( recNum)).isNull( nField));
+
+	}
+
+	// Get a field as text
+	std::string dbTable::getString( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( dbRecordView( *this, readRecord( recNum)).getString( nField));
+
+	}
+
+	// Get a field as a double
+	double dbTable::getDouble( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( dbRecordView( *this, readRecord( recNum)).getDouble( nField));
+
+	}
+
+	// Get a field as an integer
+	std::int64_t dbTable::getInt64( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( dbRecordView( *this, readRecord( recNum)).getInt64( nField));
+
+	}
+
+	// Get a logical field
+	bool dbTable::getBool( const size_t recNum, const size_t nField) const {
+
+		checkField( recNum, nField);
+		return( dbRecordView( *this, readRecord( recNum)).getBool( nField));
+
+	}
+
+	/////////////////
+	// RECORD VIEW //
+	/////////////////
+
+	dbRecordView::dbRecordView() : pTable( (const dbTable *) 0x0), pRecordBytes( (const BYTE *) 0x0) {
+
+	}
+
+	dbRecordView::dbRecordView( const dbTable &table, const BYTE *pRecord) : pTable( &table), pRecordBytes( pRecord) {
+
+	}
+
+	dbRecordView::~dbRecordView() {
+
+	}
+
+	// Is the record deleted?
+	bool dbRecordView::isDeleted() const {
+
+		return( ((const BYTE *) 0x0 != pRecordBytes) && ('*' == pRecordBytes[0]));
+
+	}
+
+	// Get the bytes of a field
+	const char * dbRecordView::getFieldBytes( const size_t nField) const {
+
+		if( (const BYTE *) 0x0 == pRecordBytes) {
+			throw( new dbException( std::string( "Empty record view")));
+		}
+		return( ((const char *) pRecordBytes) + pTable -> getFieldOffset( nField));
+
+	}
+
+	// Is the field blank?
+	bool dbRecordView::isNull( const size_t nField) const {
+
+		const char *pText = getFieldBytes( nField);
+		size_t nFirst = 0;
+		size_t nLast = pTable -> getFields()[nField].getLength();
+		trimBlanks( pText, nFirst, nLast);
+		return( nLast == nFirst);
+
+	}
+
+	// Get a field as text
+	std::string dbRecordView::getString( const size_t nField) const {
+
+		const char *pText = getFieldBytes( nField);
+		return( std::string( pText, getTextLength( pText, pTable -> getFields()[nField].getLength())));
+
+	}
+
+	// Get a field as a double
+	double dbRecordView::getDouble( const size_t nField) const {
+
+		return( parseDouble( getFieldBytes( nField), pTable -> getFields()[nField].getLength()));
+
+	}
+
+	// Get a field as an integer
+	std::int64_t dbRecordView::getInt64( const size_t nField) const {
+
+		return( parseInt64( getFieldBytes( nField), pTable -> getFields()[nField].getLength()));
+
+	}
+
+	// Get a logical field
+	bool dbRecordView::getBool( const size_t nField) const {
+
+		return( parseBool( getFieldBytes( nField), pTable -> getFields()[nField].getLength()));
+
+	}
+
+	// Decode a run of records into their column values
+	static void decodeRecords( const BYTE *pRecords, const size_t recSize, const size_t nFirstRecord, const size_t numRecords,
+		CNT_COLUMNS &columns, const std::vector<size_t> &offsets, const std::vector<size_t> &lengths) {
+
+		for( size_t nRec = 0; numRecords > nRec; ++ nRec) {
+			const char *pRecord = (const char *) (pRecords + (nRec * recSize));
+			for( size_t nColumn = 0; columns.size() > nColumn; ++ nColumn) {
+				columns[nColumn].decodeValue( nFirstRecord + nRec, pRecord + offsets[nColumn], lengths[nColumn]);
+			}
+		}
+
+	}
+
+	// Decodes blocks of mapped records into columns
+	class ColumnDecodeTask : public ParallelTask {
+
+	public:
+
+		// The number of records in each block
+		const static size_t RECORDS_PER_BLOCK = 16384;
+
+		// Construction
+		ColumnDecodeTask( const BYTE *pRecords, const size_t recordSize, const size_t numRecords,
+			CNT_COLUMNS &columns, const std::vector<size_t> &offsets, const std::vector<size_t> &lengths) :
+			pFirstRecord(pRecords), recSize(recordSize), nRecords(numRecords), cntColumns(columns), fieldOffsets(offsets), fieldLengths(lengths) {
+		}
+
+		// Destruction
+		virtual ~ColumnDecodeTask() {
+		}
+
+		// Decode one block of records
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * RECORDS_PER_BLOCK;
+			size_t nLast = nFirst + RECORDS_PER_BLOCK;
+			if( nRecords < nLast) nLast = nRecords;
+			decodeRecords( pFirstRecord + (nFirst * recSize), recSize, nFirst, nLast - nFirst, cntColumns, fieldOffsets, fieldLengths);
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (nRecords + RECORDS_PER_BLOCK - 1) / RECORDS_PER_BLOCK);
+		}
+
+	protected:
+
+		// The records
+		const BYTE *pFirstRecord;
+		size_t recSize;
+		size_t nRecords;
+
+		// The columns
+		CNT_COLUMNS &cntColumns;
+
+		// Where each column's field lies in a record
+		const std::vector<size_t> &fieldOffsets;
+		const std::vector<size_t> &fieldLengths;
+
+	};
+
+	// Decode whole columns
+	void dbTable::readColumns( CNT_COLUMNS &columns, const unsigned int numThreads) {
+
+		// Streamed records only come in order
+		if( (InputSource *) 0x0 != pSource) {
+			throw( new dbException( std::string( "Records of a streamed table can only be read in order")));
+		}
+
+		// Locate each column's field, and size the column
+		std::vector<size_t> offsets;
+		std::vector<size_t> lengths;
+		ITR_COLUMNS itrColumn = columns.begin();
+		for( ; columns.end() != itrColumn; ++ itrColumn) {
+			if( cntFields.size() <= itrColumn -> getField()) {
+				char errMsg [1000];
+				sprintf( errMsg, "Field %lu out of range, table has %lu fields", itrColumn -> getField(), cntFields.size());
+				throw( new dbException( std::string( errMsg)));
+			}
+			offsets.push_back( fieldOffsets[itrColumn -> getField()]);
+			lengths.push_back( cntFields[itrColumn -> getField()].getLength());
+			itrColumn -> resize( numRecords);
+		}
+		if( columns.empty() || (0 == numRecords)) {
+			return;
+		}
+
+		// Mapped records decode in parallel
+		if( (const BYTE *) 0x0 != pImage) {
+			ColumnDecodeTask task( pImage + hdrSize, recSize, numRecords, columns, offsets, lengths);
+			runParallel( task, task.getBlockCount(), numThreads);
+			return;
+		}
+
+		// Otherwise read a block of records at a time
+		const size_t RECORDS_PER_READ = 1024;
+		std::vector<BYTE> readBuffer( RECORDS_PER_READ * recSize);
+		if( 0x0 != fseek( fileDB, hdrSize, SEEK_SET)) {
+			throw( new dbException( std::string( "Unable to seek to requested record position")));
+		}
+		for( size_t nFirst = 0; numRecords > nFirst; nFirst += RECORDS_PER_READ) {
+			size_t numRead = ((numRecords - nFirst) < RECORDS_PER_READ) ? (numRecords - nFirst) : RECORDS_PER_READ;
+			if( numRead != fread( &readBuffer[0], recSize, numRead, fileDB)) {
+				throw( new dbException( std::string( "Failure to read record from file")));
+			}
+			decodeRecords( &readBuffer[0], recSize, nFirst, numRead, columns, offsets, lengths);
+		}
+
+	}
+
+	//////////////////
+	// RECORD SCANS //
+	//////////////////
+
+	// Construct a text predicate
+	dbPredicate::dbPredicate( const size_t nFieldIndex, const E_PREDICATE_OP eOp, const std::string &strText) :
+		nField(nFieldIndex), ePredicateOp(eOp), strValue(strText), value(0.0) {
+
+		if( !isText()) {
+			throw( new dbException( std::string( "Numeric comparison needs a numeric value")));
+		}
+
+	}
+
+	// Construct a numeric predicate
+	dbPredicate::dbPredicate( const size_t nFieldIndex, const E_PREDICATE_OP eOp, const double dblValue) :
+		nField(nFieldIndex), ePredicateOp(eOp), value(dblValue) {
+
+		if( isText()) {
+			throw( new dbException( std::string( "Text comparison needs a text value")));
+		}
+
+	}
+
+	// Destruct a predicate
+	dbPredicate::~dbPredicate() {
+
+	}
+
+	// The number of field bytes compared at once
+	static const size_t SCAN_CHUNK = 16;
+
+	// A predicate laid out against the record
+	struct s_scan_test {
+		size_t offset;				// Of the field within the record
+		size_t length;				// Of the field
+		dbPredicate::E_PREDICATE_OP eOp;
+		double value;
+		bool bText;
+		bool bNever;				// The text can never fit the field
+		size_t numChunks;			// Of the field, rounded up
+		std::vector<BYTE> pattern;		// The expected bytes
+		std::vector<BYTE> blanks;		// 0xFF where a NUL will do for the expected blank
+		std::vector<BYTE> ignored;		// 0xFF where any byte will do
+	};
+	typedef struct s_scan_test S_SCAN_TEST;
+	typedef std::vector<S_SCAN_TEST> CNT_SCAN_TESTS;
+
+	// Lay out each predicate against the record
+	static void compileTests( const dbTable &table, const CNT_PREDICATES &predicates, CNT_SCAN_TESTS &tests) {
+
+		const CNT_FIELDS &fields = table.getFields();
+		CITR_PREDICATES itrPred = predicates.begin();
+		for( ; predicates.end() != itrPred; ++ itrPred) {
+
+			// Locate the field
+			if( fields.size() <= itrPred -> getField()) {
+				char errMsg [1000];
+				sprintf( errMsg, "Field %lu out of range, table has %lu fields", itrPred -> getField(), fields.size());
+				throw( new dbException( std::string( errMsg)));
+			}
+			S_SCAN_TEST test;
+			test.offset = table.getFieldOffset( itrPred -> getField());
+			test.length = fields[itrPred -> getField()].getLength();
+			test.eOp = itrPred -> getOp();
+			test.value = itrPred -> getValue();
+			test.bText = itrPred -> isText();
+			test.bNever = false;
+			test.numChunks = (test.length + SCAN_CHUNK - 1) / SCAN_CHUNK;
+
+			// Numbers are parsed, but only for records that pass the text tests
+			if( !test.bText) {
+				tests.push_back( test);
+				continue;
+			}
+
+			// Equality ignores trailing blanks on both sides, so the rest of the field must be blank
+			bool bEquals = (dbPredicate::PO_TEXT_EQUALS == test.eOp);
+			const std::string &strText = itrPred -> getText();
+			size_t textLength = bEquals ? getTextLength( strText.data(), strText.size()) : strText.size();
+			test.bNever = (textLength > test.length);
+			size_t numBytes = test.numChunks * SCAN_CHUNK;
+			test.pattern.assign( numBytes, 0x0);
+			test.blanks.assign( numBytes, 0x0);
+			test.ignored.assign( numBytes, 0xFF);
+			for( size_t nByte = 0; (test.length > nByte) && !test.bNever; ++ nByte) {
+				if( textLength > nByte) {
+					test.pattern[nByte] = (BYTE) strText[nByte];
+					test.ignored[nByte] = 0x0;
+				}
+				else if( bEquals) {
+					test.pattern[nByte] = ' ';
+					test.blanks[nByte] = 0xFF;
+					test.ignored[nByte] = 0x0;
+				}
+			}
+			tests.push_back( test);
+
+		}
+
+	}
+
+	// Compare field text a byte at a time
+	static bool matchTextScalar( const S_SCAN_TEST &test, const BYTE *pField) {
+
+		for( size_t nByte = 0; test.length > nByte; ++ nByte) {
+			if( test.ignored[nByte] || (test.pattern[nByte] == pField[nByte]) || (test.blanks[nByte] && (0x0 == pField[nByte]))) {
+				continue;
+			}
+			return( false);
+		}
+		return( true);
+
+	}
+
+	// Compare field text sixteen bytes at a time - reads whole chunks, so may run past the field
+#if defined( LIBSHAPE_SSE2)
+	static bool matchTextSSE2( const S_SCAN_TEST &test, const BYTE *pField) {
+
+		const __m128i vZero = _mm_setzero_si128();
+		for( size_t nChunk = 0; test.numChunks > nChunk; ++ nChunk) {
+			size_t nByte = nChunk * SCAN_CHUNK;
+			__m128i field = _mm_loadu_si128( (const __m128i *) (pField + nByte));
+			__m128i match = _mm_cmpeq_epi8( field, _mm_loadu_si128( (const __m128i *) &test.pattern[nByte]));
+			match = _mm_or_si128( match, _mm_and_si128( _mm_cmpeq_epi8( field, vZero), _mm_loadu_si128( (const __m128i *) &test.blanks[nByte])));
+			match = _mm_or_si128( match, _mm_loadu_si128( (const __m128i *) &test.ignored[nByte]));
+			if( 0xFFFF != _mm_movemask_epi8( match)) {
+				return( false);
+			}
+		}
+		return( true);
+
+	}
+#endif
+
+	// Does a record pass every test?  Fields are only read in whole chunks when they end before pEnd
+	static bool matchRecord( const CNT_SCAN_TESTS &tests, const BYTE *pRecord, const BYTE *pEnd, const bool bVector) {
+
+		CNT_SCAN_TESTS::const_iterator itrTest = tests.begin();
+		for( ; tests.end() != itrTest; ++ itrTest) {
+
+			const BYTE *pField = pRecord + itrTest -> offset;
+			bool bMatch = false;
+			if( itrTest -> bNever) {
+				return( false);
+			}
+			else if( itrTest -> bText) {
+				bool bChunks = false;
+#if defined( LIBSHAPE_SSE2)
+				bChunks = bVector && ((size_t) (pEnd - pField) >= (itrTest -> numChunks * SCAN_CHUNK));
+				if( bChunks) {
+					bMatch = matchTextSSE2( *itrTest, pField);
+				}
+#endif
+				if( !bChunks) {
+					bMatch = matchTextScalar( *itrTest, pField);
+				}
+			}
+			else {
+				// Blank fields are NaN, which compares false every way
+				double fieldValue = parseDouble( (const char *) pField, itrTest -> length);
+				switch( itrTest -> eOp) {
+					case dbPredicate::PO_EQUAL :
+						bMatch = (fieldValue == itrTest -> value);
+						break;
+					case dbPredicate::PO_LESS :
+						bMatch = (fieldValue < itrTest -> value);
+						break;
+					case dbPredicate::PO_LESS_EQUAL :
+						bMatch = (fieldValue <= itrTest -> value);
+						break;
+					case dbPredicate::PO_GREATER :
+						bMatch = (fieldValue > itrTest -> value);
+						break;
+					case dbPredicate::PO_GREATER_EQUAL :
+						bMatch = (fieldValue >= itrTest -> value);
+						break;
+					default :
+						break;
+				}
+			}
+			if( !bMatch) {
+				return( false);
+			}
+
+		}
+		return( true);
+
+	}
+
+	// Scan a run of records into the bitmap
+	static void scanRecordRun( const BYTE *pRecords, const BYTE *pEnd, const size_t recSize, const size_t nFirstRecord, const size_t numRecords,
+		const CNT_SCAN_TESTS &tests, std::uint64_t *pBitmap, const bool bVector) {
+
+		for( size_t nRec = 0; numRecords > nRec; ++ nRec) {
+			if( matchRecord( tests, pRecords + (nRec * recSize), pEnd, bVector)) {
+				size_t recNum = nFirstRecord + nRec;
+				pBitmap[recNum / 64] |= ((std::uint64_t) 1) << (recNum % 64);
+			}
+		}
+
+	}
+
+	// Scans blocks of mapped records
+	class RecordScanTask : public ParallelTask {
+
+	public:
+
+		// The number of records in each block - a multiple of 64, so blocks never share bitmap words
+		const static size_t RECORDS_PER_BLOCK = 16384;
+
+		// Construction
+		RecordScanTask( const BYTE *pRecords, const BYTE *pImageEnd, const size_t recordSize, const size_t numRecords,
+			const CNT_SCAN_TESTS &tests, std::uint64_t *pBitmap, const bool bVector) :
+			pFirstRecord(pRecords), pEnd(pImageEnd), recSize(recordSize), nRecords(numRecords), cntTests(tests), pBits(pBitmap), bUseVector(bVector) {
+		}
+
+		// Destruction
+		virtual ~RecordScanTask() {
+		}
+
+		// Scan one block of records
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * RECORDS_PER_BLOCK;
+			size_t nLast = nFirst + RECORDS_PER_BLOCK;
+			if( nRecords < nLast) nLast = nRecords;
+			scanRecordRun( pFirstRecord + (nFirst * recSize), pEnd, recSize, nFirst, nLast - nFirst, cntTests, pBits, bUseVector);
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (nRecords + RECORDS_PER_BLOCK - 1) / RECORDS_PER_BLOCK);
+		}
+
+	protected:
+
+		// The records
+		const BYTE *pFirstRecord;
+		const BYTE *pEnd;
+		size_t recSize;
+		size_t nRecords;
+
+		// The tests
+		const CNT_SCAN_TESTS &cntTests;
+
+		// The results
+		std::uint64_t *pBits;
+
+		// Compare text in chunks?
+		bool bUseVector;
+
+	};
+
+	// Scan for matching records
+	void dbTable::scanRecords( const CNT_PREDICATES &predicates, std::vector<std::uint64_t> &bitmap, const unsigned int numThreads) {
+
+		// Streamed records only come in order
+		if( (InputSource *) 0x0 != pSource) {
+			throw( new dbException( std::string( "Records of a streamed table can only be read in order")));
+		}
+
+		// Lay out the tests
+		CNT_SCAN_TESTS tests;
+		compileTests( *this, predicates, tests);
+		bitmap.assign( (numRecords + 63) / 64, 0);
+		if( 0 == numRecords) {
+			return;
+		}
+		bool bVector = (SIMD_NONE != getSimdLevel());
+
+		// Mapped records scan in parallel
+		if( (const BYTE *) 0x0 != pImage) {
+			RecordScanTask task( pImage + hdrSize, pImage + imageSize, recSize, numRecords, tests, &bitmap[0], bVector);
+			runParallel( task, task.getBlockCount(), numThreads);
+			return;
+		}
+
+		// Otherwise read a block of records at a time, with room to read whole chunks past the last
+		const size_t RECORDS_PER_READ = 1024;
+		std::vector<BYTE> readBuffer( (RECORDS_PER_READ * recSize) + SCAN_CHUNK);
+		if( 0x0 != fseek( fileDB, hdrSize, SEEK_SET)) {
+			throw( new dbException( std::string( "Unable to seek to requested record position")));
+		}
+		for( size_t nFirst = 0; numRecords > nFirst; nFirst += RECORDS_PER_READ) {
+			size_t numRead = ((numRecords - nFirst) < RECORDS_PER_READ) ? (numRecords - nFirst) : RECORDS_PER_READ;
+			if( numRead != fread( &readBuffer[0], recSize, numRead, fileDB)) {
+				throw( new dbException( std::string( "Failure to read record from file")));
+			}
+			scanRecordRun( &readBuffer[0], &readBuffer[0] + readBuffer.size(), recSize, nFirst, numRead, tests, &bitmap[0], bVector);
+		}
+
+	}
+
+	// List the matching records
+	void dbTable::findRecords( const CNT_PREDICATES &predicates, std::vector<size_t> &recNums, const unsigned int numThreads) {
+
+		std::vector<std::uint64_t> bitmap;
+		scanRecords( predicates, bitmap, numThreads);
+		recNums.clear();
+		for( size_t nWord = 0; bitmap.size() > nWord; ++ nWord) {
+			for( std::uint64_t bits = bitmap[nWord]; 0 != bits; bits &= (bits - 1)) {
+				recNums.push_back( (nWord * 64) + __builtin_ctzll( bits));
+			}
+		}
+
+	}
+
+};
@@ -35,6 +35,7 @@
 // Standard includes
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
 
@@ -43,6 +44,10 @@
 
 // Project includes
 #include <libShapeFile.hpp>
+#include <libShapeArena.hpp>
+#include <libShapeSimd.hpp>
+#include <libShapeStream.hpp>
+#include <libShapeThreads.hpp>
 
 namespace libShape {
 
@@ -107,6 +112,28 @@ namespace libShape {
 
 	}
 
+	void decodeShapeHeader( const BYTE *pBuffer, S_SHAPE_HEADER &header) {
+
+		header.fileCode = getInteger(pBuffer + 0);
+		header.unused_1 = getInteger(pBuffer + 4);
+		header.unused_2 = getInteger(pBuffer + 8);
+		header.unused_3 = getInteger(pBuffer + 12);
+		header.unused_4 = getInteger(pBuffer + 16);
+		header.unused_5 = getInteger(pBuffer + 20);
+		header.fileLength = 2 * getInteger(pBuffer + 24);
+		header.version = * ((std::int32_t *) (pBuffer + 28));
+		header.shapeType = * ((std::int32_t *) (pBuffer + 32));
+		header.boundingBox.Xmin = * ((double *) (pBuffer + 36));
+		header.boundingBox.Ymin = * ((double *) (pBuffer + 44));
+		header.boundingBox.Xmax = * ((double *) (pBuffer + 52));
+		header.boundingBox.Ymax = * ((double *) (pBuffer + 60));
+		header.Zmin = * ((double *) (pBuffer + 68));
+		header.Zmax = * ((double *) (pBuffer + 76));
+		header.Mmin = * ((double *) (pBuffer + 84));
+		header.Mmax = * ((double *) (pBuffer + 92));
+
+	}
+
 	E_SHAPE_TYPE convertIntToShape( const int nShapeValue) {
 
 		E_SHAPE_TYPE eShapeType = SHAPE_INVALID;
@@ -214,7 +241,7 @@ namespace libShape {
 		return(output);
 	}
 
-	int onLeftSide( const S_POINT vertex1, const S_POINT vertex2, const S_POINT ptToCheck) {
+	int onLeftSide( const S_POINT &vertex1, const S_POINT &vertex2, const S_POINT &ptToCheck) {
 
 		double part1 = (vertex2.x - vertex1.x) * (ptToCheck.y - vertex1.y);
 		double part2 = (ptToCheck.x - vertex1.x) * (vertex2.y - vertex1.y);
@@ -224,7 +251,7 @@ namespace libShape {
 
 	}
 
-	bool onRightSide( const S_POINT vertex1, const S_POINT vertex2, const S_POINT ptToCheck) {
+	bool onRightSide( const S_POINT &vertex1, const S_POINT &vertex2, const S_POINT &ptToCheck) {
 
 		// Calculate angle between the vectors
 		// cos(theta) = (dot product) / ( (length 1) * (length 2) )
@@ -253,42 +280,32 @@ namespace libShape {
 
 	}
 
-	int getWindingNumber( const POLYGON polygon, const S_POINT ptToCheck, const bool debug) {
+	int getWindingNumber( const POLYGON &polygon, const S_POINT &ptToCheck) {
 
-		// Loop over all points
-		int windingNumber = 0x0;
-		CITR_POINTS itrPoints = polygon.begin();
-		long nPos = 0;
-		for( ; polygon.end() != itrPoints; ++ itrPoints, ++ nPos) {
+		// Empty?
+		if( polygon.empty()) {
+			return( 0);
+		}
 
-			// Get current and next point
-			const S_POINT & curPoint = *itrPoints;
-			CITR_POINTS nextItr = itrPoints;
-			++ nextItr;
-			if( polygon.end() == nextItr) {
-				nextItr = polygon.begin();
-			}
-			const S_POINT & nextPoint = *nextItr;
-
-			// Winding logic (http://geomalgorithms.com/a03-_inclusion.html)
-			if( curPoint.y <= ptToCheck.y) {
-				// Upward crossing?
-				if( nextPoint.y > ptToCheck.y) {
-					if( onLeftSide( curPoint, nextPoint, ptToCheck) > 0) {
-						++ windingNumber;	// valid up intersect
-					}
-				}
-			}
-			else {
-				// Downward crossing?
-				if( nextPoint.y <= ptToCheck.y) {
-					if( onLeftSide( curPoint, nextPoint, ptToCheck) < 0) {
-						-- windingNumber;	// valid down intersect
-					}
-				}
-			}
+		// The points are read in place, every x and y a whole point apart
+		const size_t stride = sizeof( S_POINT) / sizeof( double);
+		return( getWindingNumber( &polygon[0].x, &polygon[0].y, polygon.size(), ptToCheck.x, ptToCheck.y, stride));
 
-		} // endfor loop over points
+	}
+
+	int getWindingNumber( const double *pX, const double *pY, const size_t numPoints, const double x, const double y, const size_t stride) {
+
+		// Empty?
+		if( 0 == numPoints) {
+			return( 0);
+		}
+
+		// Every edge but the last runs to the following point
+		int windingNumber = countCrossings( pX, pY, numPoints - 1, x, y, stride);
+
+		// And the last wraps to the first
+		size_t nLast = (numPoints - 1) * stride;
+		windingNumber += getEdgeCrossing( pX[nLast], pY[nLast], pX[0], pY[0], x, y);
 
 		// And done
 		return( windingNumber);
@@ -318,7 +335,7 @@ namespace libShape {
 	// Construction of reader class
 	const unsigned long Reader::MAXIMUM_RECORD_SIZE = 16 * 1024 * 1024 - 100;
 	const unsigned long Reader::SHAPES_RESERVE_SIZE = 7500;
-	Reader::Reader( FILE *fShapeFile, const bool bStrict) {
+	Reader::Reader( FILE *fShapeFile, const bool bStrict, const bool bReadAhead) : pArena( (ShapeArena *) 0x0) {
 
 		// Allocate a very large buffer
 		shapes.reserve(SHAPES_RESERVE_SIZE);
@@ -331,79 +348,270 @@ namespace libShape {
 			throw( new ShapeException( std::string("NULL shape file")));
 		}
 
-		// Attempt to read the raw header information
-		BYTE headerBuff[100];
-		memset(headerBuff, 0x0, sizeof(headerBuff));
-		if( 100 != fread( headerBuff, sizeof(BYTE), 100, fShapeFile)) {
-			throw( new ShapeException( std::string("Insufficient bytes to gather shape file header")));
+		// Stream every record from the file
+		if( bReadAhead) {
+			ReadAheadSource source( fShapeFile);
+			decodeStream( source, bStrict);
+		}
+		else {
+			FileSource source( fShapeFile);
+			decodeStream( source, bStrict);
+		}
+
+	}
+
+	// Construction of reader class - from a sequential input
+	Reader::Reader( InputSource &source, const bool bStrict) : pArena( (ShapeArena *) 0x0) {
+
+		// Allocate a very large buffer
+		shapes.reserve(SHAPES_RESERVE_SIZE);
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// And decode
+		decodeStream( source, bStrict);
+
+	}
+
+	// Decode an entire shape file from a sequential input
+	void Reader::decodeStream( InputSource &source, const bool bStrict) {
+
+		// The stream reads the header, then one record at a time
+		StreamReader stream( source, bStrict);
+		header = stream.getShapeHeader();
+
+		// Collect every shape - those collected are released if a record fails
+		AbstractShape *nextShape = (AbstractShape *) 0x0;
+		try {
+			while( (AbstractShape *) 0x0 != (nextShape = stream.nextShape())) {
+				shapes.push_back(nextShape);
+			}
 		}
-		header.fileCode = getInteger(headerBuff + 0);
-		header.unused_1 = getInteger(headerBuff + 4);
-		header.unused_2 = getInteger(headerBuff + 8);
-		header.unused_3 = getInteger(headerBuff + 12);
-		header.unused_4 = getInteger(headerBuff + 16);
-		header.unused_5 = getInteger(headerBuff + 20);
-		header.fileLength = 2 * getInteger(headerBuff + 24);
-		header.version = * ((std::int32_t *) (headerBuff + 28));
-		header.shapeType = * ((std::int32_t *) (headerBuff + 32));
-		header.boundingBox.Xmin = * ((double *) (headerBuff + 36));
-		header.boundingBox.Ymin = * ((double *) (headerBuff + 44));
-		header.boundingBox.Xmax = * ((double *) (headerBuff + 52));
-		header.boundingBox.Ymax = * ((double *) (headerBuff + 60));
-		header.Zmin = * ((double *) (headerBuff + 68));
-		header.Zmax = * ((double *) (headerBuff + 76));
-		header.Mmin = * ((double *) (headerBuff + 84));
-		header.Mmax = * ((double *) (headerBuff + 92));
-
-		// Allocate the giant read buffer
-		BYTE *pBuffer = new BYTE[MAXIMUM_RECORD_SIZE];
-		if( (BYTE *) 0x0 == pBuffer) {
+		catch( ...) {
+			clearShapes();
+			throw;
+		}
+
+	}
+
+	// Construction of reader class - map the named shape file
+	Reader::Reader( const char *strShapeFile, const bool bStrict, const unsigned int numThreads) : pArena( (ShapeArena *) 0x0) {
+
+		// Allocate a very large buffer
+		shapes.reserve(SHAPES_RESERVE_SIZE);
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const char *) 0x0 == strShapeFile) {
+			throw( new ShapeException( std::string("NULL shape file")));
+		}
+
+		// Map the file and decode directly from the mapping
+		MappedFile shapeMap( strShapeFile);
+		if( !shapeMap.isValid()) {
 			char msg[1024 + 1];
-			sprintf( msg, "Unable to read allocate read buffer with size %lu", MAXIMUM_RECORD_SIZE);
+			snprintf( msg, sizeof( msg), "Unable to map shape file %s: %s", strShapeFile, strerror( shapeMap.getError()));
 			throw( new ShapeException( std::string( msg)));
 		}
+		decodeImage( shapeMap.getData(), shapeMap.getSize(), bStrict, numThreads);
 
-		// Now read all the records
-		unsigned long nCurRec = 0;
-		while(!feof(fShapeFile)) {
+	}
 
-			int nRecordNumber = 0x0;
-			int nRecordSize = 0x0;
-			BYTE recStart[8];
-			memset(recStart, 0x0, sizeof(recStart));
+	// Construction of reader class - from a caller owned image
+	Reader::Reader( const BYTE *pData, const size_t dataSize, const bool bStrict, const unsigned int numThreads) : pArena( (ShapeArena *) 0x0) {
 
-			// Read the record number and size
-			size_t tRead = fread( recStart, sizeof(BYTE), 8, fShapeFile);
-			if( (0x0 == tRead) && feof(fShapeFile))
-				break;
-			else if( 8 != tRead) {
+		// Allocate a very large buffer
+		shapes.reserve(SHAPES_RESERVE_SIZE);
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const BYTE *) 0x0 == pData) {
+			throw( new ShapeException( std::string("NULL shape file image")));
+		}
+
+		// And decode
+		decodeImage( pData, dataSize, bStrict, numThreads);
+
+	}
+
+	// Construction of reader class - map the named shape file into an arena
+	Reader::Reader( const char *strShapeFile, ShapeArena &arena, const bool bStrict) : pArena( &arena) {
+
+		// Allocate a very large buffer
+		shapes.reserve(SHAPES_RESERVE_SIZE);
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const char *) 0x0 == strShapeFile) {
+			throw( new ShapeException( std::string("NULL shape file")));
+		}
+
+		// Map the file and decode directly from the mapping
+		MappedFile shapeMap( strShapeFile);
+		if( !shapeMap.isValid()) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to map shape file %s: %s", strShapeFile, strerror( shapeMap.getError()));
+			throw( new ShapeException( std::string( msg)));
+		}
+		decodeImage( shapeMap.getData(), shapeMap.getSize(), bStrict, 1);
+
+	}
+
+	// Construction of reader class - from a caller owned image into an arena
+	Reader::Reader( const BYTE *pData, const size_t dataSize, ShapeArena &arena, const bool bStrict) : pArena( &arena) {
+
+		// Allocate a very large buffer
+		shapes.reserve(SHAPES_RESERVE_SIZE);
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const BYTE *) 0x0 == pData) {
+			throw( new ShapeException( std::string("NULL shape file image")));
+		}
+
+		// And decode
+		decodeImage( pData, dataSize, bStrict, 1);
+
+	}
+
+	// Decodes blocks of records from an image into their slots
+	class RecordDecodeTask : public ParallelTask {
+
+	public:
+
+		// The number of records in each block
+		const static size_t RECORDS_PER_BLOCK = 1024;
+
+		// Construction
+		RecordDecodeTask( const BYTE *pData, const std::vector<size_t> &offsets, CNT_SHAPES &shapes, ShapeArena *pShapeArena, const bool bStrict) :
+			pImage(pData), recOffsets(offsets), recShapes(shapes), pArena(pShapeArena), bStrictRecords(bStrict) {
+		}
+
+		// Destruction
+		virtual ~RecordDecodeTask() {
+		}
+
+		// Decode one block of records
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * RECORDS_PER_BLOCK;
+			size_t nLast = nFirst + RECORDS_PER_BLOCK;
+			if( recOffsets.size() < nLast) nLast = recOffsets.size();
+			for( size_t nRec = nFirst; nLast > nRec; ++ nRec) {
+
+				// Build the shape - records too short to hold a shape type are invalid
+				const BYTE *pRecord = pImage + recOffsets[nRec];
+				int nRecordNumber = getInteger( pRecord + 0);
+				int nRecordSize = 2 * getInteger( pRecord + 4);
+				AbstractShape *nextShape = (AbstractShape *) 0x0;
+				if( (ShapeArena *) 0x0 != pArena) {
+					nextShape = buildArenaShape( *pArena, nRecordNumber, pRecord + 8, nRecordSize);
+				}
+				else {
+					nextShape = buildShape(nRecordNumber, pRecord + 8, nRecordSize);
+					if( (AbstractShape *) 0x0 == nextShape) {
+						nextShape = new ShapeInvalid(nRecordNumber);
+					}
+				}
+
+				// Strict decoding fails on invalid records
+				if( bStrictRecords && (SHAPE_INVALID == nextShape->getShapeType())) {
+					if( (ShapeArena *) 0x0 == pArena) {
+						delete nextShape;
+					}
+					char msg[1024 + 1];
+					sprintf( msg, "At current record %lu, record %d is not a valid shape", (unsigned long) nRec, nRecordNumber);
+					throw( new ShapeException( std::string( msg)));
+				}
+				recShapes[nRec] = nextShape;
+
+			}
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (recOffsets.size() + RECORDS_PER_BLOCK - 1) / RECORDS_PER_BLOCK);
+		}
+
+	protected:
+
+		// The image
+		const BYTE *pImage;
+
+		// The offset of each record
+		const std::vector<size_t> &recOffsets;
+
+		// The decoded shapes
+		CNT_SHAPES &recShapes;
+
+		// The arena to build in (if any)
+		ShapeArena *pArena;
+
+		// Do invalid records throw?
+		bool bStrictRecords;
+
+	};
+
+	// Decode an entire shape file image
+	void Reader::decodeImage( const BYTE *pData, const size_t dataSize, const bool bStrict, const unsigned int numThreads) {
+
+		// Decode the header
+		if( 100 > dataSize) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather shape file header")));
+		}
+		decodeShapeHeader( pData, header);
+
+		// First a quick pass over the record headers alone
+		std::vector<size_t> offsets;
+		unsigned long nCurRec = 0;
+		size_t curPos = 100;
+		while( dataSize > curPos) {
+
+			// Get the record size
+			size_t tAvail = dataSize - curPos;
+			if( 8 > tAvail) {
 				char msg[1024 + 1];
-				sprintf( msg, "Unable to read record header at current record %lu - expected 8 bytes got %lu bytes", nCurRec, tRead);
+				sprintf( msg, "Unable to read record header at current record %lu - expected 8 bytes got %lu bytes", nCurRec, tAvail);
 				throw( new ShapeException( std::string( msg)));
 			}
-			nRecordNumber = getInteger( recStart + 0);
-			nRecordSize = 2 * getInteger( recStart + 4);
+			int nRecordSize = 2 * getInteger( pData + curPos + 4);
+			tAvail -= 8;
 
-			// Read in this value
-			tRead = fread(pBuffer, sizeof(BYTE), nRecordSize, fShapeFile);
-			if(tRead != nRecordSize) {
+			// The record must be entirely within the image
+			if( (0 > nRecordSize) || (tAvail < (size_t) nRecordSize)) {
 				char msg[1024 + 1];
-				sprintf( msg, "At current record %lu, expected to read %d but only read %lu", nCurRec, nRecordSize, tRead);
+				sprintf( msg, "At current record %lu, expected to read %d but only read %lu", nCurRec, nRecordSize, tAvail);
 				throw( new ShapeException( std::string( msg)));
 			}
 
-			// Build the shape
-			AbstractShape *nextShape = buildShape(nRecordNumber, pBuffer, tRead);
-			shapes.push_back(nextShape);
-
-			// And increment the count
+			// And advance
+			offsets.push_back( curPos);
+			curPos += 8 + nRecordSize;
 			++nCurRec;
 
 		}
 
-		// And clear the buffer
-		delete [] pBuffer;
-		pBuffer = (BYTE *) 0x0;
+		// Then decode the records in place, in parallel, keeping file order
+		// (an arena is not thread safe, so arena decoding is sequential)
+		shapes.assign( offsets.size(), (AbstractShape *) 0x0);
+		RecordDecodeTask task( pData, offsets, shapes, pArena, bStrict);
+		try {
+			runParallel( task, task.getBlockCount(), ((ShapeArena *) 0x0 == pArena) ? numThreads : 1);
+		}
+		catch( ...) {
+			clearShapes();
+			throw;
+		}
 
 	}
 
@@ -411,10 +619,20 @@ namespace libShape {
 	Reader::~Reader() {
 
 		// Clear the accumulated shapes
-		ITR_SHAPES itr = shapes.begin();
-		for(; shapes.end() != itr; ++ itr) {
-			AbstractShape *pShape = *itr;
-			delete pShape;
+		clearShapes();
+
+	}
+
+	// Release the accumulated shapes
+	void Reader::clearShapes() {
+
+		// Arena shapes are released with the arena
+		if( (ShapeArena *) 0x0 == pArena) {
+			ITR_SHAPES itr = shapes.begin();
+			for(; shapes.end() != itr; ++ itr) {
+				AbstractShape *pShape = *itr;
+				delete pShape;
+			}
 		}
 		shapes.clear();
 
@@ -460,25 +678,30 @@ namespace libShape {
 
 	ShapePoint::ShapePoint( const int recordNum, const BYTE *pBuffer, const size_t bufSize) : AbstractShape( recordNum, SHAPE_POINT) {
 
-		// Must be at least 8 bytes
-		if( 8 > bufSize) {
+		// Must be at least 16 bytes
+		if( 16 > bufSize) {
 			throw( new ShapeException( std::string( "Insufficient bytes for point shape")));
 		}
 
 		// Capture the point
+		memset( &sPoint, 0x0, sizeof( sPoint));
 		sPoint.x = * ((double *) (pBuffer + 0));
-		sPoint.y = * ((double *) (pBuffer + 4));
+		sPoint.y = * ((double *) (pBuffer + 8));
+
+		// The bounding box is the point itself
+		boundingBox.Xmin = boundingBox.Xmax = sPoint.x;
+		boundingBox.Ymin = boundingBox.Ymax = sPoint.y;
 
 	}
 
 	ShapePoint::ShapePoint(const ShapePoint &copyShape) : AbstractShape( copyShape.nRecordNum, SHAPE_POINT) {
-		sPoint.x = copyShape.sPoint.x;
-		sPoint.y = copyShape.sPoint.y;
+		sPoint = copyShape.sPoint;
+		boundingBox = copyShape.boundingBox;
 	}
 
 	ShapePoint & ShapePoint::operator=( const ShapePoint &copyShape) {
-		sPoint.x = copyShape.sPoint.x;
-		sPoint.y = copyShape.sPoint.y;
+		sPoint = copyShape.sPoint;
+		boundingBox = copyShape.boundingBox;
 		return(*this);
 	}
 
@@ -502,10 +725,10 @@ namespace libShape {
 		// Get the number of parts and points
 		numParts = * ((int *) (pBuffer + 32));
 		numPoints = * ((int *) (pBuffer + 36));
-		cntPolylines.reserve(numParts);
-		if(bufSize < (40 + (4 * numParts) + (8 * numPoints))) {
+		if( (0 > numParts) || (0 > numPoints) || (bufSize < (40 + (4 * (size_t) numParts) + (16 * (size_t) numPoints)))) {
 			throw( new ShapeException( std::string( "Exceeded structure size reading points")));
 		}
+		cntPolylines.reserve(numParts);
 
 		// Get the number of points in each line
 		std::vector<int> lstPoints;
@@ -526,7 +749,7 @@ namespace libShape {
 			POLYLINE nextPolyLine;
 			nextPolyLine.reserve(nPoints);
 			for( int nPoint = 0; nPoints > nPoint; ++ nPoint, curPos += 16) {
-				if(bufSize < curPos) {
+				if(bufSize < (curPos + 16)) {
 					throw( new ShapeException( std::string( "Exceeded structure size reading points")));
 				}
 				S_POINT nextPoint;
@@ -600,10 +823,10 @@ namespace libShape {
 		// Get the number of parts and points
 		numParts = * ((int *) (pBuffer + 32));
 		numPoints = * ((int *) (pBuffer + 36));
-		cntPolygons.reserve(numParts);
-		if(bufSize < (40 + (4 * numParts) + (8 * numPoints))) {
+		if( (0 > numParts) || (0 > numPoints) || (bufSize < (40 + (4 * (size_t) numParts) + (16 * (size_t) numPoints)))) {
 			throw( new ShapeException( std::string( "Exceeded structure size reading points")));
 		}
+		cntPolygons.reserve(numParts);
 
 		// Get the number of points in each polygon
 		std::vector<int> lstPoints;
@@ -624,7 +847,7 @@ namespace libShape {
 			POLYGON nextPolygon;
 			nextPolygon.reserve(nPoints);
 			for( int nPoint = 0; nPoints > nPoint; ++ nPoint, curPos += 16) {
-				if(bufSize < curPos) {
+				if(bufSize < (curPos + 16)) {
 					throw( new ShapeException( std::string( "Exceeded structure size reading points")));
 				}
 				S_POINT nextPoint;
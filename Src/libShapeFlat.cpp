@@ -0,0 +1,625 @@
+//
+//  libShapeFlat.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// STL includes
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Project includes
+#include <libShapeFlat.hpp>
+#include <libShapeView.hpp>
+
+namespace libShape {
+
+	////////////////
+	// FLAT SHAPE //
+	////////////////
+
+	FlatShape::FlatShape( const int recordNum, const E_SHAPE_TYPE shapeType, const S_BOUNDING_BOX &box,
+		const size_t numParts, const size_t *pPartStarts, const double *pX, const double *pY) :
+		AbstractShape( recordNum, shapeType), nParts(numParts), pStarts(pPartStarts), pXs(pX), pYs(pY) {
+
+		boundingBox = box;
+
+	}
+
+	FlatShape::~FlatShape() {
+
+	}
+
+	bool FlatShape::containsPoint( double x, double y) const {
+
+		// Points must match
+		if( SHAPE_POINT == eShapeType) {
+			if( (0 == nParts) || (0 == getPartSize( 0))) return( false);
+			const double *pX = getPartX( 0);
+			const double *pY = getPartY( 0);
+			bool bSame = dblEquals( pX[0], x) && dblEquals( pY[0], y);
+			return( bSame);
+		}
+
+		// Only polygons contain anything else
+		if( SHAPE_POLYGON != eShapeType) {
+			return( false);
+		}
+
+		// Same rules as ShapePolygon
+		bool atLeastOneContained = false;
+		bool noLeftCircles = true;
+		for( size_t nPart = 0; nParts > nPart; ++ nPart) {
+
+			// Winding number of current point must be negative (right circling)
+			int checkPtWindingNumber = getWindingNumber( getPartX( nPart), getPartY( nPart), getPartSize( nPart), x, y);
+
+			// Need at least one contained inside, and no left circling
+			noLeftCircles &= (0 >= checkPtWindingNumber);
+			atLeastOneContained |= (0 > checkPtWindingNumber);
+
+		} // endfor loop thru parts
+
+		// And done
+		return( noLeftCircles && atLeastOneContained);
+
+	}
+
+	////////////////
+	// FLAT LAYER //
+	////////////////
+
+	// Construction - empty
+	FlatLayer::FlatLayer() :
+		bExternal( false) {
+
+		memset( &header, 0x0, sizeof( header));
+		partStarts.push_back( 0);
+		shapeStarts.push_back( 0);
+		attachVectors();
+
+	}
+
+	// Construction - map the named shape file
+	FlatLayer::FlatLayer( const char *strShapeFile) :
+		bExternal( false) {
+
+		memset( &header, 0x0, sizeof( header));
+		partStarts.push_back( 0);
+		shapeStarts.push_back( 0);
+		attachVectors();
+
+		// Error?
+		if( (const char *) 0x0 == strShapeFile) {
+			throw( new ShapeException( std::string("NULL shape file")));
+		}
+
+		// Map the file and decode directly from the mapping
+		MappedFile shapeMap( strShapeFile);
+		if( !shapeMap.isValid()) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to map shape file %s: %s", strShapeFile, strerror( shapeMap.getError()));
+			throw( new ShapeException( std::string( msg)));
+		}
+		decodeImage( shapeMap.getData(), shapeMap.getSize());
+
+	}
+
+	// Construction - from a caller owned image
+	FlatLayer::FlatLayer( const BYTE *pData, const size_t dataSize) :
+		bExternal( false) {
+
+		memset( &header, 0x0, sizeof( header));
+		partStarts.push_back( 0);
+		shapeStarts.push_back( 0);
+		attachVectors();
+
+		// Error?
+		if( (const BYTE *) 0x0 == pData) {
+			throw( new ShapeException( std::string("NULL shape file image")));
+		}
+		decodeImage( pData, dataSize);
+
+	}
+
+	// Construction - from decoded shapes
+	FlatLayer::FlatLayer( const CNT_SHAPES &shapes) :
+		bExternal( false) {
+
+		memset( &header, 0x0, sizeof( header));
+		partStarts.push_back( 0);
+		shapeStarts.push_back( 0);
+		attachVectors();
+
+		// Copy every shape
+		CITR_SHAPES itr = shapes.begin();
+		for( ; shapes.end() != itr; ++ itr) {
+			if( (AbstractShape *) 0x0 != *itr) {
+				addShape( **itr);
+			}
+		}
+
+	}
+
+	// Construction - over arrays held elsewhere
+	FlatLayer::FlatLayer( const S_SHAPE_HEADER &shapeHeader, const size_t numShapes, const size_t numParts, const size_t numPoints,
+		const double *pX, const double *pY, const size_t *pParts, const size_t *pShapes,
+		const S_BOUNDING_BOX *pBoxArray, const int *pRecords, const BYTE *pTypes) :
+		header( shapeHeader), bExternal( true), nShapes( numShapes), nParts( numParts), nPoints( numPoints),
+		pXs( pX), pYs( pY), pPartStarts( pParts), pShapeStarts( pShapes),
+		pBoxes( pBoxArray), pRecordNums( pRecords), pShapeTypes( pTypes) {
+
+		// Error?
+		if( ((const size_t *) 0x0 == pParts) || ((const size_t *) 0x0 == pShapes)) {
+			throw( new ShapeException( std::string("NULL part or shape offsets")));
+		}
+		if( (0 < numPoints) && (((const double *) 0x0 == pX) || ((const double *) 0x0 == pY))) {
+			throw( new ShapeException( std::string("NULL coordinate arrays")));
+		}
+		if( (0 < numShapes) && (((const S_BOUNDING_BOX *) 0x0 == pBoxArray) || ((const int *) 0x0 == pRecords) || ((const BYTE *) 0x0 == pTypes))) {
+			throw( new ShapeException( std::string("NULL per shape arrays")));
+		}
+
+	}
+
+	// Copying
+	FlatLayer::FlatLayer( const FlatLayer &copyLayer) :
+		bExternal( false) {
+
+		*this = copyLayer;
+
+	}
+
+	FlatLayer & FlatLayer::operator=( const FlatLayer &copyLayer) {
+
+		if( this != &copyLayer) {
+			header = copyLayer.header;
+			xs = copyLayer.xs;
+			ys = copyLayer.ys;
+			partStarts = copyLayer.partStarts;
+			shapeStarts = copyLayer.shapeStarts;
+			boxes = copyLayer.boxes;
+			recordNums = copyLayer.recordNums;
+			shapeTypes = copyLayer.shapeTypes;
+		}
+
+		// Share arrays held elsewhere, otherwise use the copied vectors
+		bExternal = copyLayer.bExternal;
+		if( bExternal) {
+			nShapes = copyLayer.nShapes;
+			nParts = copyLayer.nParts;
+			nPoints = copyLayer.nPoints;
+			pXs = copyLayer.pXs;
+			pYs = copyLayer.pYs;
+			pPartStarts = copyLayer.pPartStarts;
+			pShapeStarts = copyLayer.pShapeStarts;
+			pBoxes = copyLayer.pBoxes;
+			pRecordNums = copyLayer.pRecordNums;
+			pShapeTypes = copyLayer.pShapeTypes;
+		}
+		else {
+			attachVectors();
+		}
+		return( *this);
+
+	}
+
+	// Destruction
+	FlatLayer::~FlatLayer() {
+
+	}
+
+	// Get a view of a shape
+	FlatShape FlatLayer::getShape( const size_t nShape) const {
+
+		size_t nFirstPart = pShapeStarts[nShape];
+		size_t numParts = pShapeStarts[nShape + 1] - nFirstPart;
+		FlatShape shape( pRecordNums[nShape], (E_SHAPE_TYPE) pShapeTypes[nShape], pBoxes[nShape],
+			numParts, pPartStarts + nFirstPart, pXs, pYs);
+		return( shape);
+
+	}
+
+	// Point the arrays in use at the vectors
+	void FlatLayer::attachVectors() {
+
+		nShapes = recordNums.size();
+		nParts = partStarts.size() - 1;
+		nPoints = xs.size();
+		pXs = xs.empty() ? (const double *) 0x0 : &xs[0];
+		pYs = ys.empty() ? (const double *) 0x0 : &ys[0];
+		pPartStarts = &partStarts[0];
+		pShapeStarts = &shapeStarts[0];
+		pBoxes = boxes.empty() ? (const S_BOUNDING_BOX *) 0x0 : &boxes[0];
+		pRecordNums = recordNums.empty() ? (const int *) 0x0 : &recordNums[0];
+		pShapeTypes = shapeTypes.empty() ? (const BYTE *) 0x0 : &shapeTypes[0];
+
+	}
+
+	// Fail unless shapes may be appended
+	void FlatLayer::checkAppend() const {
+
+		if( bExternal) {
+			throw( new ShapeException( std::string("Unable to append shapes to a layer over arrays held elsewhere")));
+		}
+
+	}
+
+	// Decode an image
+	void FlatLayer::decodeImage( const BYTE *pData, const size_t dataSize) {
+
+		// Decode the header
+		if( 100 > dataSize) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather shape file header")));
+		}
+		decodeShapeHeader( pData, header);
+
+		// Size everything first, so each array is allocated only once
+		size_t numShapes = 0;
+		size_t numParts = 0;
+		size_t numPoints = 0;
+		size_t curPos = 100;
+		while( 8 <= (dataSize - curPos)) {
+			int nRecordSize = 2 * getInteger( pData + curPos + 4);
+			if( (0 > nRecordSize) || ((dataSize - curPos - 8) < (size_t) nRecordSize)) break;
+			const BYTE *pRecord = pData + curPos + 8;
+			if( 4 <= nRecordSize) {
+				int nShapeType = * ((std::int32_t *) pRecord);
+				if( ((SHAPE_POLYGON == nShapeType) || (SHAPE_POLYLINE == nShapeType)) && (44 <= nRecordSize)) {
+					int numImageParts = * ((std::int32_t *) (pRecord + 36));
+					int numImagePoints = * ((std::int32_t *) (pRecord + 40));
+					if( (0 < numImageParts) && (0 < numImagePoints) && ((size_t) nRecordSize >= (44 + (4 * (size_t) numImageParts) + (16 * (size_t) numImagePoints)))) {
+						numParts += numImageParts;
+						numPoints += numImagePoints;
+					}
+				}
+				else if( SHAPE_POINT == nShapeType) {
+					numParts += 1;
+					numPoints += 1;
+				}
+			}
+			++ numShapes;
+			curPos += 8 + nRecordSize;
+		}
+		xs.reserve( numPoints);
+		ys.reserve( numPoints);
+		partStarts.reserve( numParts + 1);
+		shapeStarts.reserve( numShapes + 1);
+		boxes.reserve( numShapes);
+		recordNums.reserve( numShapes);
+		shapeTypes.reserve( numShapes);
+
+		// Now decode all the records in place
+		unsigned long nCurRec = 0;
+		curPos = 100;
+		while( dataSize > curPos) {
+
+			// Get the record number and size
+			size_t tAvail = dataSize - curPos;
+			if( 8 > tAvail) {
+				char msg[1024 + 1];
+				sprintf( msg, "Unable to read record header at current record %lu - expected 8 bytes got %lu bytes", nCurRec, tAvail);
+				throw( new ShapeException( std::string( msg)));
+			}
+			int nRecordNumber = getInteger( pData + curPos + 0);
+			int nRecordSize = 2 * getInteger( pData + curPos + 4);
+			curPos += 8;
+			tAvail -= 8;
+
+			// The record must be entirely within the image
+			if( (0 > nRecordSize) || (tAvail < (size_t) nRecordSize)) {
+				char msg[1024 + 1];
+				sprintf( msg, "At current record %lu, expected to read %d but only read %lu", nCurRec, nRecordSize, tAvail);
+				throw( new ShapeException( std::string( msg)));
+			}
+
+			// Decode and advance
+			addRecord( nRecordNumber, pData + curPos, nRecordSize);
+			curPos += nRecordSize;
+			++nCurRec;
+
+		}
+
+	}
+
+	// Append an empty shape
+	void FlatLayer::addEmpty( const int recordNum, const E_SHAPE_TYPE shapeType) {
+
+		S_BOUNDING_BOX box;
+		memset( &box, 0x0, sizeof( box));
+		endShape( recordNum, shapeType, box);
+
+	}
+
+	// Close off a shape whose parts have been appended
+	void FlatLayer::endShape( const int recordNum, const E_SHAPE_TYPE shapeType, const S_BOUNDING_BOX &box) {
+
+		shapeStarts.push_back( partStarts.size() - 1);
+		boxes.push_back( box);
+		recordNums.push_back( recordNum);
+		shapeTypes.push_back( (BYTE) shapeType);
+		attachVectors();
+
+	}
+
+	// Append a decoded shape
+	void FlatLayer::addShape( const AbstractShape &shape) {
+
+		checkAppend();
+
+		// Points
+		const ShapePoint *pPoint = dynamic_cast<const ShapePoint *>( &shape);
+		if( (const ShapePoint *) 0x0 != pPoint) {
+			const S_POINT &point = pPoint->getPoint();
+			xs.push_back( point.x);
+			ys.push_back( point.y);
+			partStarts.push_back( xs.size());
+			S_BOUNDING_BOX box = { point.x, point.y, point.x, point.y };
+			endShape( shape.getRecordNumber(), SHAPE_POINT, box);
+			return;
+		}
+
+		// Polylines and polygons
+		const CNT_POINTS *pParts = (const CNT_POINTS *) 0x0;
+		size_t numParts = 0;
+		const ShapePolyline *pLine = dynamic_cast<const ShapePolyline *>( &shape);
+		const ShapePolygon *pPolygon = dynamic_cast<const ShapePolygon *>( &shape);
+		const FlatShape *pFlat = dynamic_cast<const FlatShape *>( &shape);
+		if( (const ShapePolyline *) 0x0 != pLine) {
+			numParts = pLine->getLines().size();
+			pParts = numParts ? &pLine->getLines()[0] : pParts;
+		}
+		else if( (const ShapePolygon *) 0x0 != pPolygon) {
+			numParts = pPolygon->getPolygons().size();
+			pParts = numParts ? &pPolygon->getPolygons()[0] : pParts;
+		}
+		else if( (const FlatShape *) 0x0 != pFlat) {
+			// Flat shapes (such as those of an arena) are copied part by part - a view of this
+			// layer is copied out first, as its points move when the arrays grow
+			const FlatShape &flat = *pFlat;
+			if( (0 < flat.getPartCount()) && !xs.empty() && (flat.getPartX( 0) >= &xs[0]) && (flat.getPartX( 0) < (&xs[0] + xs.size()))) {
+				FlatLayer copyLayer;
+				copyLayer.addShape( shape);
+				addShape( copyLayer.getShape( 0));
+				return;
+			}
+			for( size_t nPart = 0; flat.getPartCount() > nPart; ++ nPart) {
+				xs.insert( xs.end(), flat.getPartX( nPart), flat.getPartX( nPart) + flat.getPartSize( nPart));
+				ys.insert( ys.end(), flat.getPartY( nPart), flat.getPartY( nPart) + flat.getPartSize( nPart));
+				partStarts.push_back( xs.size());
+			}
+			endShape( shape.getRecordNumber(), shape.getShapeType(), shape.getBoundingBox());
+			return;
+		}
+		else if( ((const ShapeNull *) 0x0 != dynamic_cast<const ShapeNull *>( &shape))
+			|| ((const ShapeInvalid *) 0x0 != dynamic_cast<const ShapeInvalid *>( &shape))) {
+			// Null and invalid shapes carry no geometry
+			addEmpty( shape.getRecordNumber(), shape.getShapeType());
+			return;
+		}
+		else {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to add record %d - its geometry of type %d cannot be read", shape.getRecordNumber(), (int) shape.getShapeType());
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Copy every part
+		for( size_t nPart = 0; numParts > nPart; ++ nPart) {
+			CITR_POINTS itrPoints = pParts[nPart].begin();
+			for( ; pParts[nPart].end() != itrPoints; ++ itrPoints) {
+				xs.push_back( itrPoints->x);
+				ys.push_back( itrPoints->y);
+			}
+			partStarts.push_back( xs.size());
+		}
+		endShape( shape.getRecordNumber(), shape.getShapeType(), shape.getBoundingBox());
+
+	}
+
+	// Append a shape record
+	void FlatLayer::addRecord( const int recordNum, const BYTE *pBuffer, const size_t bufSize) {
+
+		checkAppend();
+
+		// Records too short to hold a shape type are invalid
+		if( 4 > bufSize) {
+			addEmpty( recordNum, SHAPE_INVALID);
+			return;
+		}
+		E_SHAPE_TYPE eShapeType = convertIntToShape( * ((std::int32_t *) pBuffer));
+		const BYTE *pContent = pBuffer + 4;
+		const size_t contentSize = bufSize - 4;
+
+		// Points
+		if( SHAPE_POINT == eShapeType) {
+			PointView point( recordNum, pContent, contentSize);
+			xs.push_back( point.getX());
+			ys.push_back( point.getY());
+			partStarts.push_back( xs.size());
+			endShape( recordNum, SHAPE_POINT, point.getBoundingBox());
+			return;
+		}
+
+		// Everything else, except polylines and polygons, carries no geometry
+		if( (SHAPE_POLYLINE != eShapeType) && (SHAPE_POLYGON != eShapeType)) {
+			addEmpty( recordNum, (SHAPE_NULL == eShapeType) ? SHAPE_NULL : SHAPE_INVALID);
+			return;
+		}
+
+		// Points outside of any part are not kept
+		PartsView view( recordNum, eShapeType, pContent, contentSize);
+		int numParts = view.getPartCount();
+		int numPoints = view.getPointCount();
+		if( 0 == numParts) {
+			endShape( recordNum, eShapeType, view.getBoundingBox());
+			return;
+		}
+
+		// Copy the part offsets
+		size_t nBase = xs.size();
+		for( int nPart = 1; numParts > nPart; ++ nPart) {
+			partStarts.push_back( nBase + view.getPartStart( nPart));
+		}
+		partStarts.push_back( nBase + numPoints);
+
+		// And the points, split into x and y
+		xs.resize( nBase + numPoints);
+		ys.resize( nBase + numPoints);
+		for( int nPoint = 0; numPoints > nPoint; ++ nPoint) {
+			xs[nBase + nPoint] = view.getX( nPoint);
+			ys[nBase + nPoint] = view.getY( nPoint);
+		}
+		endShape( recordNum, eShapeType, view.getBoundingBox());
+
+	}
+
+	// Get the index along a Hilbert curve of a point on a 65536 by 65536 grid
+	static std::uint32_t getHilbertKey( std::uint32_t nX, std::uint32_t nY) {
+
+		std::uint32_t nKey = 0;
+		for( std::uint32_t nSide = 0x8000; 0 < nSide; nSide >>= 1) {
+			std::uint32_t nRight = (0 != (nX & nSide)) ? 1 : 0;
+			std::uint32_t nUpper = (0 != (nY & nSide)) ? 1 : 0;
+			nKey += nSide * nSide * ((3 * nRight) ^ nUpper);
+
+			// Rotate the quadrant so the curve within it runs the same way
+			if( 0 == nUpper) {
+				if( 1 == nRight) {
+					nX = 0xFFFF - nX;
+					nY = 0xFFFF - nY;
+				}
+				std::swap( nX, nY);
+			}
+		}
+		return( nKey);
+
+	}
+
+	// Reorder the shapes along a Hilbert curve
+	void FlatLayer::sortHilbert( std::vector<size_t> *pOrder) {
+
+		// The extent of every shape with points
+		S_BOUNDING_BOX extent = { 0.0, 0.0, 0.0, 0.0 };
+		bool bHasExtent = false;
+		for( size_t nShape = 0; nShapes > nShape; ++ nShape) {
+			if( pPartStarts[pShapeStarts[nShape]] == pPartStarts[pShapeStarts[nShape + 1]]) {
+				continue;
+			}
+			const S_BOUNDING_BOX &box = pBoxes[nShape];
+			if( !bHasExtent) {
+				extent = box;
+				bHasExtent = true;
+				continue;
+			}
+			if( box.Xmin < extent.Xmin) extent.Xmin = box.Xmin;
+			if( box.Xmax > extent.Xmax) extent.Xmax = box.Xmax;
+			if( box.Ymin < extent.Ymin) extent.Ymin = box.Ymin;
+			if( box.Ymax > extent.Ymax) extent.Ymax = box.Ymax;
+		}
+		double scaleX = (extent.Xmax > extent.Xmin) ? (65535.0 / (extent.Xmax - extent.Xmin)) : 0.0;
+		double scaleY = (extent.Ymax > extent.Ymin) ? (65535.0 / (extent.Ymax - extent.Ymin)) : 0.0;
+
+		// Key every shape by the centre of its box - shapes without points go last, in their current order
+		std::vector< std::pair<std::uint64_t, size_t> > order;
+		order.reserve( nShapes);
+		for( size_t nShape = 0; nShapes > nShape; ++ nShape) {
+			std::uint64_t nKey = 0x100000000ULL;
+			if( pPartStarts[pShapeStarts[nShape]] != pPartStarts[pShapeStarts[nShape + 1]]) {
+				const S_BOUNDING_BOX &box = pBoxes[nShape];
+				double gridX = ((((box.Xmin + box.Xmax) / 2.0) - extent.Xmin) * scaleX) + 0.5;
+				double gridY = ((((box.Ymin + box.Ymax) / 2.0) - extent.Ymin) * scaleY) + 0.5;
+				std::uint32_t nX = (0.0 < gridX) ? ((65535.0 < gridX) ? 65535 : (std::uint32_t) gridX) : 0;
+				std::uint32_t nY = (0.0 < gridY) ? ((65535.0 < gridY) ? 65535 : (std::uint32_t) gridY) : 0;
+				nKey = getHilbertKey( nX, nY);
+			}
+			order.push_back( std::make_pair( nKey, nShape));
+		}
+		std::sort( order.begin(), order.end());
+
+		// Copy every array in the new order
+		std::vector<double> sortedXs;
+		std::vector<double> sortedYs;
+		std::vector<size_t> sortedParts;
+		std::vector<size_t> sortedShapes;
+		std::vector<S_BOUNDING_BOX> sortedBoxes;
+		std::vector<int> sortedRecords;
+		std::vector<BYTE> sortedTypes;
+		sortedXs.reserve( nPoints);
+		sortedYs.reserve( nPoints);
+		sortedParts.reserve( nParts + 1);
+		sortedShapes.reserve( nShapes + 1);
+		sortedBoxes.reserve( nShapes);
+		sortedRecords.reserve( nShapes);
+		sortedTypes.reserve( nShapes);
+		sortedParts.push_back( 0);
+		sortedShapes.push_back( 0);
+		for( size_t nSorted = 0; order.size() > nSorted; ++ nSorted) {
+			size_t nShape = order[nSorted].second;
+			for( size_t nPart = pShapeStarts[nShape]; pShapeStarts[nShape + 1] > nPart; ++ nPart) {
+				sortedXs.insert( sortedXs.end(), pXs + pPartStarts[nPart], pXs + pPartStarts[nPart + 1]);
+				sortedYs.insert( sortedYs.end(), pYs + pPartStarts[nPart], pYs + pPartStarts[nPart + 1]);
+				sortedParts.push_back( sortedXs.size());
+			}
+			sortedShapes.push_back( sortedParts.size() - 1);
+			sortedBoxes.push_back( pBoxes[nShape]);
+			sortedRecords.push_back( pRecordNums[nShape]);
+			sortedTypes.push_back( pShapeTypes[nShape]);
+		}
+
+		// And use them - a layer over arrays held elsewhere now holds its own
+		xs.swap( sortedXs);
+		ys.swap( sortedYs);
+		partStarts.swap( sortedParts);
+		shapeStarts.swap( sortedShapes);
+		boxes.swap( sortedBoxes);
+		recordNums.swap( sortedRecords);
+		shapeTypes.swap( sortedTypes);
+		bExternal = false;
+		attachVectors();
+
+		// The old index of every shape
+		if( (std::vector<size_t> *) 0x0 != pOrder) {
+			pOrder->resize( order.size());
+			for( size_t nSorted = 0; order.size() > nSorted; ++ nSorted) {
+				(*pOrder)[nSorted] = order[nSorted].second;
+			}
+		}
+
+	}
+
+};
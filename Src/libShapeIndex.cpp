@@ -0,0 +1,300 @@
+//
+//  libShapeIndex.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Project includes
+#include <libShapeIndex.hpp>
+
+namespace libShape {
+
+	/////////////////
+	// SHAPE INDEX //
+	/////////////////
+
+	// Construction - read the entire index file
+	ShapeIndex::ShapeIndex( FILE *fIndexFile) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (FILE *) 0x0 == fIndexFile) {
+			throw( new ShapeException( std::string("NULL index file")));
+		}
+
+		// Read the header to learn the file length
+		BYTE headerBuff[100];
+		memset(headerBuff, 0x0, sizeof(headerBuff));
+		if( 100 != fread( headerBuff, sizeof(BYTE), 100, fIndexFile)) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather index file header")));
+		}
+		decodeShapeHeader( headerBuff, header);
+		if( 100 > header.fileLength) {
+			throw( new ShapeException( std::string("Invalid index file length")));
+		}
+
+		// Then read all of the entries with a single read
+		std::vector<BYTE> image( header.fileLength);
+		memcpy( &image[0], headerBuff, 100);
+		size_t tWanted = header.fileLength - 100;
+		size_t tRead = fread( &image[100], sizeof(BYTE), tWanted, fIndexFile);
+		if( tWanted != tRead) {
+			char msg[1024 + 1];
+			sprintf( msg, "Expected to read %lu index bytes but only read %lu", tWanted, tRead);
+			throw( new ShapeException( std::string( msg)));
+		}
+		decodeImage( &image[0], image.size());
+
+	}
+
+	// Construction - map the named index file
+	ShapeIndex::ShapeIndex( const char *strIndexFile) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const char *) 0x0 == strIndexFile) {
+			throw( new ShapeException( std::string("NULL index file")));
+		}
+
+		// Map and decode
+		MappedFile indexMap( strIndexFile);
+		if( !indexMap.isValid()) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to map index file %s: %s", strIndexFile, strerror( indexMap.getError()));
+			throw( new ShapeException( std::string( msg)));
+		}
+		decodeImage( indexMap.getData(), indexMap.getSize());
+
+	}
+
+	// Construction - from a caller owned image
+	ShapeIndex::ShapeIndex( const BYTE *pData, const size_t dataSize) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const BYTE *) 0x0 == pData) {
+			throw( new ShapeException( std::string("NULL index file image")));
+		}
+		decodeImage( pData, dataSize);
+
+	}
+
+	// Destruction
+	ShapeIndex::~ShapeIndex() {
+
+	}
+
+	// Decode an index file image
+	void ShapeIndex::decodeImage( const BYTE *pData, const size_t dataSize) {
+
+		// Decode the header
+		if( 100 > dataSize) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather index file header")));
+		}
+		decodeShapeHeader( pData, header);
+
+		// Every entry is 8 bytes - offset and length in 16-bit words
+		size_t numEntries = (dataSize - 100) / 8;
+		entries.resize( numEntries);
+		const BYTE *pEntry = pData + 100;
+		for( size_t nEntry = 0; numEntries > nEntry; ++ nEntry, pEntry += 8) {
+			int nOffset = getInteger( pEntry + 0);
+			int nLength = getInteger( pEntry + 4);
+			if( (0 > nOffset) || (0 > nLength)) {
+				char msg[1024 + 1];
+				sprintf( msg, "Invalid offset or length for index entry %lu", nEntry);
+				throw( new ShapeException( std::string( msg)));
+			}
+			entries[nEntry].offset = 2 * (size_t) nOffset;
+			entries[nEntry].contentLength = 2 * (size_t) nLength;
+		}
+
+	}
+
+	// Get an index entry
+	const S_INDEX_ENTRY & ShapeIndex::getEntry( const int recordNum) const {
+
+		if( (1 > recordNum) || (entries.size() < (size_t) recordNum)) {
+			char msg[1024 + 1];
+			sprintf( msg, "Record number %d is outside of the index (1 to %lu)", recordNum, entries.size());
+			throw( new ShapeException( std::string( msg)));
+		}
+		return( entries[recordNum - 1]);
+
+	}
+
+	////////////////////
+	// INDEXED READER //
+	////////////////////
+
+	// Construction - random reads against an open shape file
+	IndexedReader::IndexedReader( FILE *fShapeFile, FILE *fIndexFile) : fileShape(fShapeFile), pShapeMap( (MappedFile *) 0x0), pIndex( (ShapeIndex *) 0x0) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (FILE *) 0x0 == fShapeFile) {
+			throw( new ShapeException( std::string("NULL shape file")));
+		}
+
+		// Read the shape file header
+		BYTE headerBuff[100];
+		memset(headerBuff, 0x0, sizeof(headerBuff));
+		if( 100 != pread( fileno( fileShape), headerBuff, 100, 0)) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather shape file header")));
+		}
+		decodeShapeHeader( headerBuff, header);
+
+		// And load the index
+		pIndex = new ShapeIndex( fIndexFile);
+
+	}
+
+	// Construction - map both files
+	IndexedReader::IndexedReader( const char *strShapeFile, const char *strIndexFile) : fileShape( (FILE *) 0x0), pShapeMap( (MappedFile *) 0x0), pIndex( (ShapeIndex *) 0x0) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Error?
+		if( (const char *) 0x0 == strShapeFile) {
+			throw( new ShapeException( std::string("NULL shape file")));
+		}
+
+		// Map the shape file - records are read in any order
+		pShapeMap = new MappedFile( strShapeFile, MappedFile::ACCESS_RANDOM);
+		if( !pShapeMap->isValid() || (100 > pShapeMap->getSize())) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to map shape file %s: %s", strShapeFile,
+				pShapeMap->isValid() ? "insufficient bytes for header" : strerror( pShapeMap->getError()));
+			delete pShapeMap;
+			pShapeMap = (MappedFile *) 0x0;
+			throw( new ShapeException( std::string( msg)));
+		}
+		decodeShapeHeader( pShapeMap->getData(), header);
+
+		// And load the index
+		try {
+			pIndex = new ShapeIndex( strIndexFile);
+		}
+		catch( ...) {
+			delete pShapeMap;
+			pShapeMap = (MappedFile *) 0x0;
+			throw;
+		}
+
+	}
+
+	// Destruction
+	IndexedReader::~IndexedReader() {
+
+		if( (ShapeIndex *) 0x0 != pIndex) {
+			delete pIndex;
+			pIndex = (ShapeIndex *) 0x0;
+		}
+		if( (MappedFile *) 0x0 != pShapeMap) {
+			delete pShapeMap;
+			pShapeMap = (MappedFile *) 0x0;
+		}
+
+	}
+
+	// Check a record header against the index
+	void IndexedReader::validateRecord( const int recordNum, const BYTE *pRecord) const {
+
+		const S_INDEX_ENTRY &entry = pIndex->getEntry( recordNum);
+		int nRecordNumber = getInteger( pRecord + 0);
+		size_t nRecordSize = 2 * (size_t) getInteger( pRecord + 4);
+		if( (nRecordNumber != recordNum) || (nRecordSize != entry.contentLength)) {
+			char msg[1024 + 1];
+			sprintf( msg, "Record %d at offset %lu does not match the index (found record %d with %lu bytes)",
+				recordNum, entry.offset, nRecordNumber, nRecordSize);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+	}
+
+	// Read and build a single shape
+	AbstractShape * IndexedReader::getShape( const int recordNum) {
+
+		// Find the record
+		const S_INDEX_ENTRY &entry = pIndex->getEntry( recordNum);
+		size_t recordBytes = 8 + entry.contentLength;
+
+		// Mapped?  Then decode in place
+		const BYTE *pRecord = (const BYTE *) 0x0;
+		if( (MappedFile *) 0x0 != pShapeMap) {
+			if( (entry.offset > pShapeMap->getSize()) || (recordBytes > (pShapeMap->getSize() - entry.offset))) {
+				char msg[1024 + 1];
+				sprintf( msg, "Record %d at offset %lu extends past the end of the shape file", recordNum, entry.offset);
+				throw( new ShapeException( std::string( msg)));
+			}
+			pRecord = pShapeMap->getData() + entry.offset;
+		}
+
+		// Otherwise a single positioned read of header and content
+		else {
+			if( recordBuffer.size() < recordBytes) {
+				recordBuffer.resize( recordBytes);
+			}
+			ssize_t tRead = pread( fileno( fileShape), &recordBuffer[0], recordBytes, entry.offset);
+			if( (ssize_t) recordBytes != tRead) {
+				char msg[1024 + 1];
+				sprintf( msg, "At record %d, expected to read %lu but only read %ld", recordNum, recordBytes, (long) tRead);
+				throw( new ShapeException( std::string( msg)));
+			}
+			pRecord = &recordBuffer[0];
+		}
+
+		// Records too short to hold a shape type are invalid, as when reading them all
+		validateRecord( recordNum, pRecord);
+		AbstractShape *pShape = buildShape( recordNum, pRecord + 8, entry.contentLength);
+		if( (AbstractShape *) 0x0 == pShape) {
+			pShape = new ShapeInvalid( recordNum);
+		}
+		return( pShape);
+
+	}
+
+};
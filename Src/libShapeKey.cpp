@@ -0,0 +1,346 @@
+//
+//  libShapeKey.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+
+// STL includes
+#include <string>
+
+// Project includes
+#include <libShapeKey.hpp>
+#include <libShapeMapped.hpp>
+
+namespace libShape {
+
+	// The start of an index file
+	static const char KEY_FILE_MAGIC[8] = { 'L', 'S', 'H', 'P', 'K', 'E', 'Y', '2' };
+
+	// The header of an index file - native byte order, followed by the slot records, the slot hashes and the record chains
+	struct s_key_file_header {
+		char magic[8];
+		std::uint64_t numRecords;
+		std::uint64_t recSize;
+		std::uint64_t nField;
+		std::uint64_t fieldOffset;
+		std::uint64_t fieldLength;
+		std::uint64_t numSlots;
+		S_FILE_STAMP dbStamp;
+	};
+	typedef struct s_key_file_header S_KEY_FILE_HEADER;
+
+	// Trim the blanks from both ends of a key
+	static void trimKey( const char *&pKey, size_t &keyLength) {
+		while( (0 < keyLength) && ((' ' == pKey[keyLength - 1]) || ('\0' == pKey[keyLength - 1]))) -- keyLength;
+		while( (0 < keyLength) && ((' ' == pKey[0]) || ('\0' == pKey[0]))) {
+			++ pKey;
+			-- keyLength;
+		}
+	}
+
+	// FNV-1a hash of a trimmed key
+	static std::uint64_t hashKey( const char *pKey, const size_t keyLength) {
+		std::uint64_t nHash = 0xCBF29CE484222325ULL;
+		for( size_t nByte = 0; keyLength > nByte; ++ nByte) {
+			nHash ^= (BYTE) pKey[nByte];
+			nHash *= 0x100000001B3ULL;
+		}
+		return( nHash);
+	}
+
+	// At least twice as many slots as records, and a power of two
+	static std::uint64_t sizeSlots( const std::uint64_t numRecords) {
+		std::uint64_t numSlots = 16;
+		while( numSlots < (2 * numRecords)) numSlots *= 2;
+		return( numSlots);
+	}
+
+	// Fill in the header describing the table and field
+	static void describeTable( const dbTable &table, const size_t nField, S_KEY_FILE_HEADER &header) {
+		memset( &header, 0x0, sizeof( header));
+		memcpy( header.magic, KEY_FILE_MAGIC, sizeof( header.magic));
+		header.numRecords = table.getRecordCount();
+		header.recSize = table.getRecordSize();
+		header.nField = nField;
+		header.fieldOffset = table.getFieldOffset( nField);
+		header.fieldLength = table.getFields()[nField].getLength();
+	}
+
+	// Build the index
+	dbKeyIndex::dbKeyIndex( const dbTable &table, const size_t nField) :
+		keyTable(table), nKeyField(nField), bLoaded(false) {
+
+		build();
+
+	}
+
+	// Load or build the index
+	dbKeyIndex::dbKeyIndex( const dbTable &table, const size_t nField, const char *strIndexFile, const char *strDBFile) :
+		keyTable(table), nKeyField(nField), bLoaded(false) {
+
+		// Try the file
+		if( load( strIndexFile, strDBFile)) {
+			return;
+		}
+
+		// Build, and save for next time
+		build();
+		try {
+			save( strIndexFile, strDBFile);
+		}
+		catch( dbException *pExcp) {
+			delete pExcp;
+		}
+
+	}
+
+	// Destruct the index
+	dbKeyIndex::~dbKeyIndex() {
+
+	}
+
+	// Build the slots
+	void dbKeyIndex::build() {
+
+		// Validate input
+		if( keyTable.getFields().size() <= nKeyField) {
+			char errMsg [1000];
+			sprintf( errMsg, "Field %lu out of range, table has %lu fields", nKeyField, keyTable.getFields().size());
+			throw( new dbException( std::string( errMsg)));
+		}
+
+		// Size the slots
+		size_t numRecords = keyTable.getRecordCount();
+		size_t numSlots = (size_t) sizeSlots( numRecords);
+		slotRecords.assign( numSlots, 0);
+		slotHashes.assign( numSlots, 0);
+		nextRecords.assign( numRecords, 0);
+		bLoaded = false;
+
+		// Records go in in order, each onto the end of its key's chain
+		std::vector<std::uint32_t> slotLast( numSlots, 0);
+		size_t fieldLength = keyTable.getFields()[nKeyField].getLength();
+		std::string strKey;
+		for( size_t recNum = 0; numRecords > recNum; ++ recNum) {
+			const char *pKey = keyTable.getFieldBytes( recNum, nKeyField);
+			size_t keyLength = fieldLength;
+			trimKey( pKey, keyLength);
+			std::uint64_t nHash = hashKey( pKey, keyLength);
+
+			// Reading a file table shares one record buffer, which matching overwrites - so copy the key first
+			strKey.assign( pKey, keyLength);
+			pKey = strKey.data();
+			std::uint32_t nTag = (std::uint32_t) (nHash >> 32);
+			size_t nSlot = (size_t) nHash & (numSlots - 1);
+			while( (0 != slotRecords[nSlot]) && ((nTag != slotHashes[nSlot]) || !matchRecord( slotRecords[nSlot] - 1, pKey, keyLength))) {
+				nSlot = (nSlot + 1) & (numSlots - 1);
+			}
+			if( 0 == slotRecords[nSlot]) {
+				slotRecords[nSlot] = (std::uint32_t) (recNum + 1);
+				slotHashes[nSlot] = nTag;
+			}
+			else {
+				nextRecords[slotLast[nSlot] - 1] = (std::uint32_t) (recNum + 1);
+			}
+			slotLast[nSlot] = (std::uint32_t) (recNum + 1);
+		}
+
+	}
+
+	// Does the record hold the key?
+	bool dbKeyIndex::matchRecord( const size_t recNum, const char *pKey, const size_t keyLength) const {
+
+		const char *pField = keyTable.getFieldBytes( recNum, nKeyField);
+		size_t fieldLength = keyTable.getFields()[nKeyField].getLength();
+		trimKey( pField, fieldLength);
+		return( (fieldLength == keyLength) && (0 == memcmp( pField, pKey, keyLength)));
+
+	}
+
+	// Find the first record with a key
+	long dbKeyIndex::find( const char *pKey, const size_t keyLength) const {
+
+		if( ((const char *) 0x0 == pKey) || slotRecords.empty()) {
+			return( -1);
+		}
+		size_t trimLength = keyLength;
+		trimKey( pKey, trimLength);
+		std::uint64_t nHash = hashKey( pKey, trimLength);
+		std::uint32_t nTag = (std::uint32_t) (nHash >> 32);
+		size_t mask = slotRecords.size() - 1;
+		for( size_t nSlot = (size_t) nHash & mask; 0 != slotRecords[nSlot]; nSlot = (nSlot + 1) & mask) {
+			if( (nTag == slotHashes[nSlot]) && matchRecord( slotRecords[nSlot] - 1, pKey, trimLength)) {
+				return( (long) slotRecords[nSlot] - 1);
+			}
+		}
+		return( -1);
+
+	}
+
+	// Find every record with a key
+	void dbKeyIndex::findAll( const char *pKey, const size_t keyLength, std::vector<size_t> &recNums) const {
+
+		recNums.clear();
+		if( ((const char *) 0x0 == pKey) || slotRecords.empty()) {
+			return;
+		}
+		size_t trimLength = keyLength;
+		trimKey( pKey, trimLength);
+		std::uint64_t nHash = hashKey( pKey, trimLength);
+		std::uint32_t nTag = (std::uint32_t) (nHash >> 32);
+		size_t mask = slotRecords.size() - 1;
+		for( size_t nSlot = (size_t) nHash & mask; 0 != slotRecords[nSlot]; nSlot = (nSlot + 1) & mask) {
+			if( (nTag == slotHashes[nSlot]) && matchRecord( slotRecords[nSlot] - 1, pKey, trimLength)) {
+				for( std::uint32_t nRecord = slotRecords[nSlot]; 0 != nRecord; nRecord = nextRecords[nRecord - 1]) {
+					if( matchRecord( nRecord - 1, pKey, trimLength)) {
+						recNums.push_back( nRecord - 1);
+					}
+				}
+				return;
+			}
+		}
+
+	}
+
+	// Load a saved index
+	bool dbKeyIndex::load( const char *strIndexFile, const char *strDBFile) {
+
+		// Validate input
+		if( ((const char *) 0x0 == strIndexFile) || (keyTable.getFields().size() <= nKeyField)) {
+			return( false);
+		}
+		FILE *fIndex = fopen( strIndexFile, "rb");
+		if( (FILE *) 0x0 == fIndex) {
+			return( false);
+		}
+
+		// It must describe this table and field
+		S_KEY_FILE_HEADER expected;
+		S_KEY_FILE_HEADER header;
+		describeTable( keyTable, nKeyField, expected);
+		bool bMatch = (1 == fread( &header, sizeof( header), 1, fIndex));
+		bMatch = bMatch && (0 == memcmp( header.magic, expected.magic, sizeof( header.magic)));
+		bMatch = bMatch && (header.numRecords == expected.numRecords) && (header.recSize == expected.recSize);
+		bMatch = bMatch && (header.nField == expected.nField) && (header.fieldOffset == expected.fieldOffset);
+		bMatch = bMatch && (header.fieldLength == expected.fieldLength);
+		bMatch = bMatch && (header.numSlots == sizeSlots( header.numRecords));
+		bMatch = bMatch && matchFileStamp( strDBFile, header.dbStamp);
+
+		// Read the slots
+		std::vector<std::uint32_t> newRecords;
+		std::vector<std::uint32_t> newHashes;
+		std::vector<std::uint32_t> newNext;
+		if( bMatch) {
+			newRecords.resize( header.numSlots);
+			newHashes.resize( header.numSlots);
+			newNext.resize( header.numRecords);
+			bMatch = (header.numSlots == fread( &newRecords[0], sizeof( std::uint32_t), header.numSlots, fIndex));
+			bMatch = bMatch && (header.numSlots == fread( &newHashes[0], sizeof( std::uint32_t), header.numSlots, fIndex));
+			bMatch = bMatch && (newNext.empty() || (header.numRecords == fread( &newNext[0], sizeof( std::uint32_t), header.numRecords, fIndex)));
+		}
+		fclose( fIndex);
+
+		// Every record number must be in the table, no record may head two slots, at least one
+		// slot must be empty to end the probes, and each chain must run forward through the
+		// table - so a damaged file can neither read past the table nor loop
+		std::vector<bool> isHead( bMatch ? (header.numRecords + 1) : 0, false);
+		bool bEmptySlot = false;
+		for( size_t nSlot = 0; bMatch && (newRecords.size() > nSlot); ++ nSlot) {
+			std::uint32_t nRecord = newRecords[nSlot];
+			bMatch = (header.numRecords >= nRecord) && ((0 == nRecord) || !isHead[nRecord]);
+			if( 0 == nRecord) {
+				bEmptySlot = true;
+			}
+			else if( bMatch) {
+				isHead[nRecord] = true;
+			}
+		}
+		bMatch = bMatch && bEmptySlot;
+		for( size_t recNum = 0; bMatch && (newNext.size() > recNum); ++ recNum) {
+			bMatch = (0 == newNext[recNum]) || ((recNum + 1 < newNext[recNum]) && (header.numRecords >= newNext[recNum]));
+		}
+		if( !bMatch) {
+			return( false);
+		}
+
+		// And done
+		slotRecords.swap( newRecords);
+		slotHashes.swap( newHashes);
+		nextRecords.swap( newNext);
+		bLoaded = true;
+		return( true);
+
+	}
+
+	// Save the index
+	void dbKeyIndex::save( const char *strIndexFile, const char *strDBFile) const {
+
+		// Validate input
+		if( (const char *) 0x0 == strIndexFile) {
+			throw( new dbException( std::string( "NULL index file name not permitted")));
+		}
+
+		// Describe the table and field, stamped with the DB file
+		S_KEY_FILE_HEADER header;
+		describeTable( keyTable, nKeyField, header);
+		header.numSlots = slotRecords.size();
+		if( !getFileStamp( strDBFile, header.dbStamp)) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Unable to find the DB file of index file %s", strIndexFile);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+		FILE *fIndex = fopen( strIndexFile, "wb");
+		if( (FILE *) 0x0 == fIndex) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Unable to create index file %s", strIndexFile);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+		// Header, then the slots
+		bool bWritten = (1 == fwrite( &header, sizeof( header), 1, fIndex));
+		bWritten = bWritten && (slotRecords.size() == fwrite( &slotRecords[0], sizeof( std::uint32_t), slotRecords.size(), fIndex));
+		bWritten = bWritten && (slotHashes.size() == fwrite( &slotHashes[0], sizeof( std::uint32_t), slotHashes.size(), fIndex));
+		bWritten = bWritten && (nextRecords.empty() || (nextRecords.size() == fwrite( &nextRecords[0], sizeof( std::uint32_t), nextRecords.size(), fIndex)));
+		bWritten = (0 == fclose( fIndex)) && bWritten;
+		if( !bWritten) {
+			char errMsg [1000];
+			snprintf( errMsg, sizeof( errMsg), "Unable to write index file %s", strIndexFile);
+			throw( new dbException( std::string( errMsg)));
+		}
+
+	}
+
+};
@@ -0,0 +1,194 @@
+//
+//  libShapeLayer.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+
+// STL includes
+#include <string>
+
+// Project includes
+#include <libShapeLayer.hpp>
+
+namespace libShape {
+
+	//////////////////
+	// LAYER READER //
+	//////////////////
+
+	// Construction - from sources
+	LayerReader::LayerReader( InputSource &shapeSource, InputSource &dbSource, const size_t blockSize) :
+		fShapeFile( (FILE *) 0x0), fDBFile( (FILE *) 0x0), pShapeFileSource( (FileSource *) 0x0), pDBFileSource( (FileSource *) 0x0),
+		pShapeBlocks( (BlockSource *) 0x0), pDBBlocks( (BlockSource *) 0x0), pShapes( (StreamReader *) 0x0), pTable( (dbTable *) 0x0),
+		pCurrent( (AbstractShape *) 0x0) {
+
+		try {
+			openSources( shapeSource, dbSource, blockSize);
+		}
+		catch( ...) {
+			release();
+			throw;
+		}
+
+	}
+
+	// Construction - from the named files
+	LayerReader::LayerReader( const char *strShapeFile, const char *strDBFile, const size_t blockSize) :
+		fShapeFile( (FILE *) 0x0), fDBFile( (FILE *) 0x0), pShapeFileSource( (FileSource *) 0x0), pDBFileSource( (FileSource *) 0x0),
+		pShapeBlocks( (BlockSource *) 0x0), pDBBlocks( (BlockSource *) 0x0), pShapes( (StreamReader *) 0x0), pTable( (dbTable *) 0x0),
+		pCurrent( (AbstractShape *) 0x0) {
+
+		// Validate input
+		if( ((const char *) 0x0 == strShapeFile) || ((const char *) 0x0 == strDBFile)) {
+			throw( new ShapeException( std::string( "NULL file name not permitted")));
+		}
+
+		try {
+
+			// Open both files
+			fShapeFile = fopen( strShapeFile, "rb");
+			if( (FILE *) 0x0 == fShapeFile) {
+				char msg[1024 + 1];
+				snprintf( msg, sizeof( msg), "Unable to open shape file %s", strShapeFile);
+				throw( new ShapeException( std::string( msg)));
+			}
+			fDBFile = fopen( strDBFile, "rb");
+			if( (FILE *) 0x0 == fDBFile) {
+				char msg[1024 + 1];
+				snprintf( msg, sizeof( msg), "Unable to open DB file %s", strDBFile);
+				throw( new ShapeException( std::string( msg)));
+			}
+			pShapeFileSource = new FileSource( fShapeFile);
+			pDBFileSource = new FileSource( fDBFile);
+
+			// And stream them
+			openSources( *pShapeFileSource, *pDBFileSource, blockSize);
+
+		}
+		catch( ...) {
+			release();
+			throw;
+		}
+
+	}
+
+	// Destruction
+	LayerReader::~LayerReader() {
+
+		release();
+
+	}
+
+	// Set up the readers
+	void LayerReader::openSources( InputSource &shapeSource, InputSource &dbSource, const size_t blockSize) {
+
+		InputSource *pShapeInput = &shapeSource;
+		InputSource *pDBInput = &dbSource;
+		if( 0 != blockSize) {
+			pShapeBlocks = new BlockSource( shapeSource, blockSize);
+			pDBBlocks = new BlockSource( dbSource, blockSize);
+			pShapeInput = pShapeBlocks;
+			pDBInput = pDBBlocks;
+		}
+		pShapes = new StreamReader( *pShapeInput);
+		pTable = new dbTable( *pDBInput);
+
+	}
+
+	// Release everything, readers before their sources
+	void LayerReader::release() {
+
+		delete pCurrent;
+		pCurrent = (AbstractShape *) 0x0;
+		delete pShapes;
+		pShapes = (StreamReader *) 0x0;
+		delete pTable;
+		pTable = (dbTable *) 0x0;
+		delete pShapeBlocks;
+		pShapeBlocks = (BlockSource *) 0x0;
+		delete pDBBlocks;
+		pDBBlocks = (BlockSource *) 0x0;
+		delete pShapeFileSource;
+		pShapeFileSource = (FileSource *) 0x0;
+		delete pDBFileSource;
+		pDBFileSource = (FileSource *) 0x0;
+		if( (FILE *) 0x0 != fShapeFile) {
+			fclose( fShapeFile);
+			fShapeFile = (FILE *) 0x0;
+		}
+		if( (FILE *) 0x0 != fDBFile) {
+			fclose( fDBFile);
+			fDBFile = (FILE *) 0x0;
+		}
+
+	}
+
+	// Move to the next pair
+	bool LayerReader::next() {
+
+		// Drop the current pair
+		delete pCurrent;
+		pCurrent = (AbstractShape *) 0x0;
+		currentRow = dbRecordView();
+
+		// The next shape
+		pCurrent = pShapes -> nextShape();
+		if( (AbstractShape *) 0x0 == pCurrent) {
+			return( false);
+		}
+
+		// And its row
+		const BYTE *pRecord = pTable -> nextRecord();
+		if( (const BYTE *) 0x0 == pRecord) {
+			char msg[1024 + 1];
+			sprintf( msg, "DB file has only %lu records, fewer than the shape file", pTable -> getRecordCount());
+			throw( new ShapeException( std::string( msg)));
+		}
+		currentRow = dbRecordView( *pTable, pRecord);
+		return( true);
+
+	}
+
+	// Get the current shape
+	const AbstractShape & LayerReader::getShape() const {
+
+		if( (AbstractShape *) 0x0 == pCurrent) {
+			throw( new ShapeException( std::string( "No current shape")));
+		}
+		return( *pCurrent);
+
+	}
+
+};
@@ -0,0 +1,162 @@
+//
+//  libShapeMapped.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Project includes
+#include <libShapeMapped.hpp>
+
+namespace libShape {
+
+	// Map the named file
+	MappedFile::MappedFile( const char *strFileName, const E_ACCESS_PATTERN eAccess) : pData( (const BYTE *) 0x0), dataSize( 0), nError( 0) {
+
+		// Validate input
+		if( (const char *) 0x0 == strFileName) {
+			nError = EINVAL;
+			return;
+		}
+
+		// Open, map and close - the mapping survives the close
+		int fd = open( strFileName, O_RDONLY);
+		if( 0 > fd) {
+			nError = errno;
+			return;
+		}
+		mapDescriptor( fd, eAccess);
+		close( fd);
+
+	}
+
+	// Map an open file
+	MappedFile::MappedFile( FILE *fFile, const E_ACCESS_PATTERN eAccess) : pData( (const BYTE *) 0x0), dataSize( 0), nError( 0) {
+
+		// Validate input
+		if( (FILE *) 0x0 == fFile) {
+			nError = EINVAL;
+			return;
+		}
+		mapDescriptor( fileno( fFile), eAccess);
+
+	}
+
+	// Release the mapping
+	MappedFile::~MappedFile() {
+
+		if( (const BYTE *) 0x0 != pData) {
+			munmap( (void *) pData, dataSize);
+			pData = (const BYTE *) 0x0;
+		}
+
+	}
+
+	// Map the descriptor
+	void MappedFile::mapDescriptor( const int fd, const E_ACCESS_PATTERN eAccess) {
+
+		// Get the file size
+		struct stat fileStat;
+		if( 0x0 != fstat( fd, &fileStat)) {
+			nError = errno;
+			return;
+		}
+
+		// An empty file is valid, but has nothing to map
+		dataSize = (size_t) fileStat.st_size;
+		if( 0 == dataSize) return;
+
+		// Map the entire file
+		void *pMap = mmap( (void *) 0x0, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if( MAP_FAILED == pMap) {
+			nError = errno;
+			dataSize = 0;
+			return;
+		}
+
+		// Tell the kernel how the file will be read - read ahead for a front to back pass,
+		// but not for lookups that jump about the file
+		switch( eAccess) {
+			case ACCESS_RANDOM:
+				madvise( pMap, dataSize, MADV_RANDOM);
+				break;
+			case ACCESS_NORMAL:
+				madvise( pMap, dataSize, MADV_NORMAL);
+				break;
+			case ACCESS_SEQUENTIAL:
+			default:
+				madvise( pMap, dataSize, MADV_SEQUENTIAL);
+				break;
+		}
+		pData = (const BYTE *) pMap;
+
+	}
+
+	/////////////////
+	// FILE STAMPS //
+	/////////////////
+
+	bool getFileStamp( const char *strFileName, S_FILE_STAMP &stamp) {
+
+		memset( &stamp, 0x0, sizeof( stamp));
+		struct stat fileStat;
+		if( ((const char *) 0x0 == strFileName) || (0 != stat( strFileName, &fileStat))) {
+			return( false);
+		}
+		stamp.fileSize = fileStat.st_size;
+		stamp.modSeconds = fileStat.st_mtime;
+#if defined( __APPLE__)
+		stamp.modNanos = fileStat.st_mtimespec.tv_nsec;
+#else
+		stamp.modNanos = fileStat.st_mtim.tv_nsec;
+#endif
+		return( true);
+
+	}
+
+	bool matchFileStamp( const char *strFileName, const S_FILE_STAMP &stamp) {
+
+		S_FILE_STAMP curStamp;
+		return( getFileStamp( strFileName, curStamp) && (curStamp.fileSize == stamp.fileSize)
+			&& (curStamp.modSeconds == stamp.modSeconds) && (curStamp.modNanos == stamp.modNanos));
+
+	}
+
+};
@@ -0,0 +1,248 @@
+//
+//  libShapePrepared.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Project includes
+#include <libShapePrepared.hpp>
+#include <libShapeSimd.hpp>
+
+namespace libShape {
+
+	//////////////////////
+	// PREPARED POLYGON //
+	//////////////////////
+
+	// The average number of edges per slab to aim for
+	static const size_t EDGES_PER_SLAB = 4;
+
+	// The most slabs for a single polygon
+	static const size_t MAX_SLABS = 1 << 20;
+
+	// Utility function - can the edge cross anything?  Edges with a non-finite
+	// end have no place in the slabs, and horizontal edges never cross
+	static inline bool isCrossingEdge( const double curX, const double curY, const double nextX, const double nextY) {
+		return( isfinite( curX) && isfinite( curY) && isfinite( nextX) && isfinite( nextY) && (curY != nextY));
+	}
+
+	// Utility function - the slab holding a y value, clamped to the slabs
+	static inline size_t getSlab( const double y, const double yMin, const double slabHeight, const size_t numSlabs) {
+		double slab = (y - yMin) / slabHeight;
+		if( !(0.0 < slab)) return( 0);
+		if( !(slab < numSlabs)) return( numSlabs - 1);
+		return( (size_t) slab);
+	}
+
+	PreparedPolygon::PreparedPolygon( const ShapePolygon &polygon) :
+		AbstractShape( polygon.getRecordNumber(), SHAPE_POLYGON), slabHeight( 0.0) {
+
+		boundingBox = polygon.getBoundingBox();
+
+		// Flatten the rings, then prepare them
+		const CNT_POLYGON &rings = polygon.getPolygons();
+		std::vector<double> xs;
+		std::vector<double> ys;
+		std::vector<size_t> ringStarts( 1, 0);
+		CITR_POLYGON itrRing = rings.begin();
+		for( ; rings.end() != itrRing; ++ itrRing) {
+			CITR_POINTS itrPoint = itrRing->begin();
+			for( ; itrRing->end() != itrPoint; ++ itrPoint) {
+				xs.push_back( itrPoint->x);
+				ys.push_back( itrPoint->y);
+			}
+			ringStarts.push_back( xs.size());
+		}
+		prepare( xs.empty() ? (const double *) 0x0 : &xs[0], ys.empty() ? (const double *) 0x0 : &ys[0], &ringStarts[0], rings.size());
+
+	}
+
+	PreparedPolygon::PreparedPolygon( const FlatShape &polygon) :
+		AbstractShape( polygon.getRecordNumber(), SHAPE_POLYGON), slabHeight( 0.0) {
+
+		boundingBox = polygon.getBoundingBox();
+
+		// The parts of a flat shape follow one another, so they are prepared in place
+		size_t numRings = polygon.getPartCount();
+		std::vector<size_t> ringStarts( 1, 0);
+		for( size_t nRing = 0; numRings > nRing; ++ nRing) {
+			ringStarts.push_back( (polygon.getPartX( nRing) - polygon.getPartX( 0)) + polygon.getPartSize( nRing));
+		}
+		prepare( (0 < numRings) ? polygon.getPartX( 0) : (const double *) 0x0, (0 < numRings) ? polygon.getPartY( 0) : (const double *) 0x0,
+			&ringStarts[0], numRings);
+
+	}
+
+	// Split the rings into slabs
+	void PreparedPolygon::prepare( const double *pX, const double *pY, const size_t *pRingStarts, const size_t numRings) {
+
+		memset( &extent, 0x0, sizeof( extent));
+
+		// Find the extent of the rings, and count the edges that can cross anything
+		size_t numEdges = 0;
+		double sumHeight = 0.0;
+		bool bFirst = true;
+		for( size_t nRing = 0; numRings > nRing; ++ nRing) {
+			size_t nStart = pRingStarts[nRing];
+			size_t nEndRing = pRingStarts[nRing + 1];
+			for( size_t nCur = nStart; nEndRing > nCur; ++ nCur) {
+				size_t nNext = (nEndRing == (nCur + 1)) ? nStart : (nCur + 1);
+				if( isCrossingEdge( pX[nCur], pY[nCur], pX[nNext], pY[nNext])) {
+					++ numEdges;
+					sumHeight += (pY[nCur] < pY[nNext]) ? (pY[nNext] - pY[nCur]) : (pY[nCur] - pY[nNext]);
+				}
+				if( !(isfinite( pX[nCur]) && isfinite( pY[nCur]))) {
+					continue;
+				}
+				if( bFirst) {
+					extent.Xmin = extent.Xmax = pX[nCur];
+					extent.Ymin = extent.Ymax = pY[nCur];
+					bFirst = false;
+				}
+				if( pX[nCur] < extent.Xmin) extent.Xmin = pX[nCur];
+				if( pX[nCur] > extent.Xmax) extent.Xmax = pX[nCur];
+				if( pY[nCur] < extent.Ymin) extent.Ymin = pY[nCur];
+				if( pY[nCur] > extent.Ymax) extent.Ymax = pY[nCur];
+			}
+		}
+
+		// Size the slabs - but no thinner than the average edge is tall, so
+		// that edges spanning several slabs at most double the entries
+		size_t numSlabs = numEdges / EDGES_PER_SLAB;
+		if( 0.0 < sumHeight) {
+			double maxSlabs = numEdges * ((extent.Ymax - extent.Ymin) / sumHeight);
+			if( maxSlabs < numSlabs) numSlabs = (size_t) maxSlabs;
+		}
+		if( 1 > numSlabs) numSlabs = 1;
+		if( MAX_SLABS < numSlabs) numSlabs = MAX_SLABS;
+		slabHeight = (extent.Ymax - extent.Ymin) / numSlabs;
+		slabStarts.assign( numSlabs + 1, 0);
+		if( 0 == numEdges) {
+			return;
+		}
+
+		// Two passes over the edges - count the entries of each slab, then place them
+		std::vector<size_t> slabFill;
+		for( int nPass = 0; 2 > nPass; ++ nPass) {
+
+			for( size_t nRing = 0; numRings > nRing; ++ nRing) {
+				size_t nStart = pRingStarts[nRing];
+				size_t nEndRing = pRingStarts[nRing + 1];
+				for( size_t nCur = nStart; nEndRing > nCur; ++ nCur) {
+
+					// Only the edges counted above
+					size_t nNext = (nEndRing == (nCur + 1)) ? nStart : (nCur + 1);
+					if( !isCrossingEdge( pX[nCur], pY[nCur], pX[nNext], pY[nNext])) {
+						continue;
+					}
+
+					// Every slab the edge spans
+					double lowY = (pY[nCur] < pY[nNext]) ? pY[nCur] : pY[nNext];
+					double highY = (pY[nCur] < pY[nNext]) ? pY[nNext] : pY[nCur];
+					size_t nFirstSlab = getSlab( lowY, extent.Ymin, slabHeight, numSlabs);
+					size_t nLastSlab = getSlab( highY, extent.Ymin, slabHeight, numSlabs);
+					for( size_t nSlab = nFirstSlab; nLastSlab >= nSlab; ++ nSlab) {
+						if( 0 == nPass) {
+							++ slabStarts[nSlab + 1];
+						}
+						else {
+							S_PREPARED_EDGE &edge = slabEdges[slabFill[nSlab] ++];
+							edge.curX = pX[nCur];
+							edge.curY = pY[nCur];
+							edge.nextX = pX[nNext];
+							edge.nextY = pY[nNext];
+							edge.nRing = nRing;
+						}
+					}
+
+				}
+			}
+
+			// After counting, turn the counts into offsets
+			if( 0 == nPass) {
+				for( size_t nSlab = 0; numSlabs > nSlab; ++ nSlab) {
+					slabStarts[nSlab + 1] += slabStarts[nSlab];
+				}
+				slabEdges.resize( slabStarts[numSlabs]);
+				slabFill.assign( slabStarts.begin(), slabStarts.end() - 1);
+			}
+
+		}
+
+	}
+
+	PreparedPolygon::~PreparedPolygon() {
+
+	}
+
+	bool PreparedPolygon::containsPoint( double x, double y) const {
+
+		// Outside the rings?  Written so that NaN coordinates are outside too
+		if( !((x >= extent.Xmin) && (x <= extent.Xmax) && (y >= extent.Ymin) && (y < extent.Ymax)) || slabEdges.empty()) {
+			return( false);
+		}
+
+		// Find the slab
+		size_t numSlabs = slabStarts.size() - 1;
+		size_t nSlab = getSlab( y, extent.Ymin, slabHeight, numSlabs);
+
+		// Same rules as ShapePolygon - rings without edges in the slab wind zero times
+		bool atLeastOneContained = false;
+		bool noLeftCircles = true;
+		size_t nEdge = slabStarts[nSlab];
+		size_t nEnd = slabStarts[nSlab + 1];
+		while( nEnd > nEdge) {
+
+			// Winding number of the ring
+			size_t nRing = slabEdges[nEdge].nRing;
+			int checkPtWindingNumber = 0;
+			for( ; (nEnd > nEdge) && (nRing == slabEdges[nEdge].nRing); ++ nEdge) {
+				const S_PREPARED_EDGE &edge = slabEdges[nEdge];
+				checkPtWindingNumber += getEdgeCrossing( edge.curX, edge.curY, edge.nextX, edge.nextY, x, y);
+			}
+
+			// Need at least one contained inside, and no left circling
+			noLeftCircles &= (0 >= checkPtWindingNumber);
+			atLeastOneContained |= (0 > checkPtWindingNumber);
+
+		} // endwhile loop thru rings
+
+		// And done
+		return( noLeftCircles && atLeastOneContained);
+
+	}
+
+};
@@ -0,0 +1,285 @@
+//
+//  libShapeSimd.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+
+// Project includes
+#include <libShapeSimd.hpp>
+
+// Vector intrinsics - SSE2 is part of every x86-64 target, AVX2 is chosen at run time
+#if defined( __SSE2__)
+#define LIBSHAPE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined( __GNUC__) && (defined( __x86_64__) || defined( __i386__))
+#define LIBSHAPE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace libShape {
+
+	//////////////
+	// DISPATCH //
+	//////////////
+
+	// Get the best instruction set the CPU supports
+	static E_SIMD_LEVEL getSupportedLevel() {
+
+#if defined( LIBSHAPE_AVX2)
+		__builtin_cpu_init();
+		if( __builtin_cpu_supports( "avx2")) {
+			return( SIMD_AVX2);
+		}
+#endif
+#if defined( LIBSHAPE_SSE2)
+		return( SIMD_SSE2);
+#else
+		return( SIMD_NONE);
+#endif
+
+	}
+
+	// The instruction set in use
+	static E_SIMD_LEVEL & currentLevel() {
+		static E_SIMD_LEVEL eLevel = getSupportedLevel();
+		return( eLevel);
+	}
+
+	E_SIMD_LEVEL getSimdLevel() {
+
+		return( currentLevel());
+
+	}
+
+	E_SIMD_LEVEL setSimdLevel( const E_SIMD_LEVEL level) {
+
+		E_SIMD_LEVEL eSupported = getSupportedLevel();
+		currentLevel() = (level > eSupported) ? eSupported : level;
+		return( currentLevel());
+
+	}
+
+	////////////
+	// SCALAR //
+	////////////
+
+	int getEdgeCrossing( const double curX, const double curY, const double nextX, const double nextY, const double x, const double y) {
+
+		// Winding logic (http://geomalgorithms.com/a03-_inclusion.html) with onLeftSide inlined
+		if( curY <= y) {
+			// Upward crossing?
+			if( nextY > y) {
+				double part1 = (nextX - curX) * (y - curY);
+				double part2 = (x - curX) * (nextY - curY);
+				if( !dblEquals( part1, part2) && (part1 > part2)) {
+					return( 1);	// valid up intersect
+				}
+			}
+		}
+		else {
+			// Downward crossing?
+			if( nextY <= y) {
+				double part1 = (nextX - curX) * (y - curY);
+				double part2 = (x - curX) * (nextY - curY);
+				if( !dblEquals( part1, part2) && (part1 < part2)) {
+					return( -1);	// valid down intersect
+				}
+			}
+		}
+		return( 0);
+
+	}
+
+	static int countCrossingsScalar( const double *pX, const double *pY, const size_t numEdges, const double x, const double y, const size_t stride) {
+
+		int windingNumber = 0;
+		for( size_t nEdge = 0; numEdges > nEdge; ++ nEdge) {
+			size_t nCur = nEdge * stride;
+			windingNumber += getEdgeCrossing( pX[nCur], pY[nCur], pX[nCur + stride], pY[nCur + stride], x, y);
+		}
+		return( windingNumber);
+
+	}
+
+	//////////
+	// SSE2 //
+	//////////
+
+	// Each lane follows getEdgeCrossing exactly - the comparisons are
+	// chosen so that NaN values fall the same way as the scalar branches,
+	// and products are never fused so they round the same way
+#if defined( LIBSHAPE_SSE2)
+	static int countCrossingsSSE2( const double *pX, const double *pY, const size_t numEdges, const double x, const double y, const size_t stride) {
+
+		const __m128d vX = _mm_set1_pd( x);
+		const __m128d vY = _mm_set1_pd( y);
+		const __m128d vSlack = _mm_set1_pd( SLACK_DOUBLES);
+		const __m128d vAbs = _mm_castsi128_pd( _mm_set1_epi64x( 0x7FFFFFFFFFFFFFFFLL));
+		__m128i vCount = _mm_setzero_si128();
+
+		size_t nEdge = 0;
+		for( ; numEdges >= (nEdge + 2); nEdge += 2) {
+
+			// Load two edges
+			const double *pCurX = pX + (nEdge * stride);
+			const double *pCurY = pY + (nEdge * stride);
+			__m128d curX, curY, nextX, nextY;
+			if( 1 == stride) {
+				curX = _mm_loadu_pd( pCurX);
+				curY = _mm_loadu_pd( pCurY);
+				nextX = _mm_loadu_pd( pCurX + 1);
+				nextY = _mm_loadu_pd( pCurY + 1);
+			}
+			else {
+				curX = _mm_set_pd( pCurX[stride], pCurX[0]);
+				curY = _mm_set_pd( pCurY[stride], pCurY[0]);
+				nextX = _mm_set_pd( pCurX[2 * stride], pCurX[stride]);
+				nextY = _mm_set_pd( pCurY[2 * stride], pCurY[stride]);
+			}
+
+			// Edges crossing the point's y - most edges of a large ring cross nowhere near it
+			__m128d up = _mm_and_pd( _mm_cmple_pd( curY, vY), _mm_cmpgt_pd( nextY, vY));
+			__m128d down = _mm_and_pd( _mm_cmpnle_pd( curY, vY), _mm_cmple_pd( nextY, vY));
+			if( 0 == _mm_movemask_pd( _mm_or_pd( up, down))) {
+				continue;
+			}
+
+			// Side of each edge
+			__m128d part1 = _mm_mul_pd( _mm_sub_pd( nextX, curX), _mm_sub_pd( vY, curY));
+			__m128d part2 = _mm_mul_pd( _mm_sub_pd( vX, curX), _mm_sub_pd( nextY, curY));
+			__m128d notEqual = _mm_cmpnle_pd( _mm_and_pd( _mm_sub_pd( part1, part2), vAbs), vSlack);
+			up = _mm_and_pd( up, _mm_and_pd( notEqual, _mm_cmpgt_pd( part1, part2)));
+			down = _mm_and_pd( down, _mm_and_pd( notEqual, _mm_cmplt_pd( part1, part2)));
+
+			// Set lanes are -1
+			vCount = _mm_sub_epi64( vCount, _mm_castpd_si128( up));
+			vCount = _mm_add_epi64( vCount, _mm_castpd_si128( down));
+
+		}
+
+		// Sum the lanes, and finish any remaining edge
+		long long lanes[2];
+		_mm_storeu_si128( (__m128i *) lanes, vCount);
+		int windingNumber = (int) (lanes[0] + lanes[1]);
+		windingNumber += countCrossingsScalar( pX + (nEdge * stride), pY + (nEdge * stride), numEdges - nEdge, x, y, stride);
+		return( windingNumber);
+
+	}
+#endif
+
+	//////////
+	// AVX2 //
+	//////////
+
+	// As for SSE2, four edges at a time
+#if defined( LIBSHAPE_AVX2)
+	__attribute__(( target( "avx2")))
+	static int countCrossingsAVX2( const double *pX, const double *pY, const size_t numEdges, const double x, const double y, const size_t stride) {
+
+		const __m256d vX = _mm256_set1_pd( x);
+		const __m256d vY = _mm256_set1_pd( y);
+		const __m256d vSlack = _mm256_set1_pd( SLACK_DOUBLES);
+		const __m256d vAbs = _mm256_castsi256_pd( _mm256_set1_epi64x( 0x7FFFFFFFFFFFFFFFLL));
+		const __m256i vIndex = _mm256_set_epi64x( 3 * stride, 2 * stride, stride, 0);
+		__m256i vCount = _mm256_setzero_si256();
+
+		size_t nEdge = 0;
+		for( ; numEdges >= (nEdge + 4); nEdge += 4) {
+
+			// Load four edges
+			const double *pCurX = pX + (nEdge * stride);
+			const double *pCurY = pY + (nEdge * stride);
+			__m256d curX, curY, nextX, nextY;
+			if( 1 == stride) {
+				curX = _mm256_loadu_pd( pCurX);
+				curY = _mm256_loadu_pd( pCurY);
+				nextX = _mm256_loadu_pd( pCurX + 1);
+				nextY = _mm256_loadu_pd( pCurY + 1);
+			}
+			else {
+				curX = _mm256_i64gather_pd( pCurX, vIndex, 8);
+				curY = _mm256_i64gather_pd( pCurY, vIndex, 8);
+				nextX = _mm256_i64gather_pd( pCurX + stride, vIndex, 8);
+				nextY = _mm256_i64gather_pd( pCurY + stride, vIndex, 8);
+			}
+
+			// Edges crossing the point's y
+			__m256d up = _mm256_and_pd( _mm256_cmp_pd( curY, vY, _CMP_LE_OQ), _mm256_cmp_pd( nextY, vY, _CMP_GT_OQ));
+			__m256d down = _mm256_and_pd( _mm256_cmp_pd( curY, vY, _CMP_NLE_UQ), _mm256_cmp_pd( nextY, vY, _CMP_LE_OQ));
+			if( 0 == _mm256_movemask_pd( _mm256_or_pd( up, down))) {
+				continue;
+			}
+
+			// Side of each edge
+			__m256d part1 = _mm256_mul_pd( _mm256_sub_pd( nextX, curX), _mm256_sub_pd( vY, curY));
+			__m256d part2 = _mm256_mul_pd( _mm256_sub_pd( vX, curX), _mm256_sub_pd( nextY, curY));
+			__m256d notEqual = _mm256_cmp_pd( _mm256_and_pd( _mm256_sub_pd( part1, part2), vAbs), vSlack, _CMP_NLE_UQ);
+			up = _mm256_and_pd( up, _mm256_and_pd( notEqual, _mm256_cmp_pd( part1, part2, _CMP_GT_OQ)));
+			down = _mm256_and_pd( down, _mm256_and_pd( notEqual, _mm256_cmp_pd( part1, part2, _CMP_LT_OQ)));
+
+			// Set lanes are -1
+			vCount = _mm256_sub_epi64( vCount, _mm256_castpd_si256( up));
+			vCount = _mm256_add_epi64( vCount, _mm256_castpd_si256( down));
+
+		}
+
+		// Sum the lanes, and finish any remaining edges
+		long long lanes[4];
+		_mm256_storeu_si256( (__m256i *) lanes, vCount);
+		int windingNumber = (int) (lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+		windingNumber += countCrossingsScalar( pX + (nEdge * stride), pY + (nEdge * stride), numEdges - nEdge, x, y, stride);
+		return( windingNumber);
+
+	}
+#endif
+
+	int countCrossings( const double *pX, const double *pY, const size_t numEdges, const double x, const double y, const size_t stride) {
+
+		switch( currentLevel()) {
+#if defined( LIBSHAPE_AVX2)
+			case SIMD_AVX2:
+				return( countCrossingsAVX2( pX, pY, numEdges, x, y, stride));
+#endif
+#if defined( LIBSHAPE_SSE2)
+			case SIMD_SSE2:
+				return( countCrossingsSSE2( pX, pY, numEdges, x, y, stride));
+#endif
+			default:
+				return( countCrossingsScalar( pX, pY, numEdges, x, y, stride));
+		}
+
+	}
+
+};
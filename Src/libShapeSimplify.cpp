@@ -0,0 +1,527 @@
+//
+//  libShapeSimplify.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// STL includes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Project includes
+#include <libShapeSimplify.hpp>
+#include <libShapeThreads.hpp>
+
+namespace libShape {
+
+	/////////////
+	// HELPERS //
+	/////////////
+
+	// The number of times a shape whose rings cross is simplified again
+	static const int MAX_SIMPLIFY_RETRIES = 4;
+
+	// Squared distance from a point to a segment
+	static double getSegmentDistance2( const double x, const double y, const double ax, const double ay, const double bx, const double by) {
+
+		double dx = bx - ax;
+		double dy = by - ay;
+		double length2 = (dx * dx) + (dy * dy);
+		double t = (0.0 < length2) ? ((((x - ax) * dx) + ((y - ay) * dy)) / length2) : 0.0;
+		if( 0.0 > t) t = 0.0;
+		if( 1.0 < t) t = 1.0;
+		double ex = x - (ax + (t * dx));
+		double ey = y - (ay + (t * dy));
+		return( (ex * ex) + (ey * ey));
+
+	}
+
+	// Find the point between two others furthest from the segment joining them - returns its squared distance
+	static double findFurthest( const double *pX, const double *pY, const size_t nFirst, const size_t nLast, size_t &nFurthest) {
+
+		double maxDistance2 = -1.0;
+		nFurthest = nFirst;
+		for( size_t nPoint = nFirst + 1; nLast > nPoint; ++ nPoint) {
+			double distance2 = getSegmentDistance2( pX[nPoint], pY[nPoint], pX[nFirst], pY[nFirst], pX[nLast], pY[nLast]);
+			if( distance2 > maxDistance2) {
+				maxDistance2 = distance2;
+				nFurthest = nPoint;
+			}
+		}
+		return( maxDistance2);
+
+	}
+
+	// Douglas-Peucker between two kept points, without recursion
+	static void simplifySpan( const double *pX, const double *pY, const size_t nFirst, const size_t nLast, const double tolerance2,
+		std::vector<BYTE> &keep, std::vector< std::pair<size_t, size_t> > &spans) {
+
+		spans.clear();
+		spans.push_back( std::make_pair( nFirst, nLast));
+		while( !spans.empty()) {
+			std::pair<size_t, size_t> span = spans.back();
+			spans.pop_back();
+			if( (span.first + 1) >= span.second) {
+				continue;
+			}
+			size_t nFurthest = 0;
+			if( findFurthest( pX, pY, span.first, span.second, nFurthest) > tolerance2) {
+				keep[nFurthest] = 1;
+				spans.push_back( std::make_pair( span.first, nFurthest));
+				spans.push_back( std::make_pair( nFurthest, span.second));
+			}
+		}
+
+	}
+
+	// Do two segments cross or touch?
+	static double getOrientation( const double ax, const double ay, const double bx, const double by, const double cx, const double cy) {
+		return( ((bx - ax) * (cy - ay)) - ((by - ay) * (cx - ax)));
+	}
+	static bool onSegment( const double ax, const double ay, const double bx, const double by, const double cx, const double cy) {
+		return( (std::min( ax, bx) <= cx) && (std::max( ax, bx) >= cx) && (std::min( ay, by) <= cy) && (std::max( ay, by) >= cy));
+	}
+	static bool segmentsMeet( const double *pA, const double *pB, const double *pC, const double *pD) {
+
+		double o1 = getOrientation( pA[0], pA[1], pB[0], pB[1], pC[0], pC[1]);
+		double o2 = getOrientation( pA[0], pA[1], pB[0], pB[1], pD[0], pD[1]);
+		double o3 = getOrientation( pC[0], pC[1], pD[0], pD[1], pA[0], pA[1]);
+		double o4 = getOrientation( pC[0], pC[1], pD[0], pD[1], pB[0], pB[1]);
+		if( (((0.0 < o1) && (0.0 > o2)) || ((0.0 > o1) && (0.0 < o2))) && (((0.0 < o3) && (0.0 > o4)) || ((0.0 > o3) && (0.0 < o4)))) {
+			return( true);
+		}
+		return( ((0.0 == o1) && onSegment( pA[0], pA[1], pB[0], pB[1], pC[0], pC[1]))
+			|| ((0.0 == o2) && onSegment( pA[0], pA[1], pB[0], pB[1], pD[0], pD[1]))
+			|| ((0.0 == o3) && onSegment( pC[0], pC[1], pD[0], pD[1], pA[0], pA[1]))
+			|| ((0.0 == o4) && onSegment( pC[0], pC[1], pD[0], pD[1], pB[0], pB[1])));
+
+	}
+
+	// A segment of a simplified shape
+	struct s_simple_segment {
+		double minX;
+		double maxX;
+		double ends[4];
+		size_t nPart;
+		size_t nIndex;
+		size_t partSize;
+	};
+	typedef struct s_simple_segment S_SIMPLE_SEGMENT;
+
+	static bool lessMinX( const S_SIMPLE_SEGMENT &left, const S_SIMPLE_SEGMENT &right) {
+		return( left.minX < right.minX);
+	}
+
+	// Are two segments neighbours in the same part?
+	static bool areNeighbours( const S_SIMPLE_SEGMENT &left, const S_SIMPLE_SEGMENT &right) {
+
+		if( left.nPart != right.nPart) {
+			return( false);
+		}
+		size_t nLow = std::min( left.nIndex, right.nIndex);
+		size_t nHigh = std::max( left.nIndex, right.nIndex);
+		return( ((nLow + 1) == nHigh) || ((0 == nLow) && ((left.partSize - 2) == nHigh)));
+
+	}
+
+	// Do any segments of the rings cross or touch, other than neighbours meeting at their shared point?
+	// Segments are swept in order of their lowest x, each tested against those still overlapping it in x
+	static bool ringsMeet( const double *pX, const double *pY, const size_t *pPartSizes, const size_t numParts,
+		std::vector<S_SIMPLE_SEGMENT> &segments, std::vector<size_t> &active) {
+
+		segments.clear();
+		size_t nBase = 0;
+		for( size_t nPart = 0; numParts > nPart; nBase += pPartSizes[nPart ++]) {
+			for( size_t nPoint = nBase; (nBase + pPartSizes[nPart]) > (nPoint + 1); ++ nPoint) {
+				S_SIMPLE_SEGMENT segment = { std::min( pX[nPoint], pX[nPoint + 1]), std::max( pX[nPoint], pX[nPoint + 1]),
+					{ pX[nPoint], pY[nPoint], pX[nPoint + 1], pY[nPoint + 1] }, nPart, nPoint - nBase, pPartSizes[nPart] };
+				segments.push_back( segment);
+			}
+		}
+		std::sort( segments.begin(), segments.end(), lessMinX);
+		active.clear();
+		for( size_t nSegment = 0; segments.size() > nSegment; ++ nSegment) {
+			const S_SIMPLE_SEGMENT &segment = segments[nSegment];
+			for( size_t nActive = 0; active.size() > nActive; ) {
+				const S_SIMPLE_SEGMENT &other = segments[active[nActive]];
+				if( other.maxX < segment.minX) {
+					active[nActive] = active.back();
+					active.pop_back();
+					continue;
+				}
+				if( !areNeighbours( segment, other) && segmentsMeet( segment.ends, segment.ends + 2, other.ends, other.ends + 2)) {
+					return( true);
+				}
+				++ nActive;
+			}
+			active.push_back( nSegment);
+		}
+		return( false);
+
+	}
+
+	// The simplified shapes of one block
+	struct s_simple_block {
+		std::vector<double> xs;
+		std::vector<double> ys;
+		std::vector<size_t> partSizes;
+		std::vector<size_t> shapeParts;
+		std::vector<S_BOUNDING_BOX> boxes;
+	};
+	typedef struct s_simple_block S_SIMPLE_BLOCK;
+
+	// Simplify the shapes of a layer, one block at a time
+	class SimplifyTask : public ParallelTask {
+
+	public:
+
+		// The number of shapes in each block
+		const static size_t SHAPES_PER_BLOCK = 256;
+
+		// Construction
+		SimplifyTask( const FlatLayer &layer, const double tolerance) :
+			rLayer(layer), levelTolerance(tolerance), blocks(getBlockCount()) {
+		}
+
+		// Destruction
+		virtual ~SimplifyTask() {
+		}
+
+		// Simplify one block of shapes
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * SHAPES_PER_BLOCK;
+			size_t nLast = nFirst + SHAPES_PER_BLOCK;
+			if( rLayer.getShapeCount() < nLast) nLast = rLayer.getShapeCount();
+			S_SIMPLE_BLOCK &block = blocks[nBlock];
+			std::vector<BYTE> keep;
+			std::vector< std::pair<size_t, size_t> > spans;
+			std::vector<S_SIMPLE_SEGMENT> segments;
+			std::vector<size_t> active;
+			for( size_t nShape = nFirst; nLast > nShape; ++ nShape) {
+
+				// Polygons are simplified until their rings no longer meet
+				FlatShape shape = rLayer.getShape( nShape);
+				bool bPolygon = (SHAPE_POLYGON == shape.getShapeType());
+				bool bSimplify = bPolygon || (SHAPE_POLYLINE == shape.getShapeType());
+				size_t nBasePoint = block.xs.size();
+				size_t nBasePart = block.partSizes.size();
+				double tolerance = levelTolerance;
+				for( int nTry = 0; ; ++ nTry) {
+					addParts( shape, bSimplify ? tolerance : 0.0, bPolygon, block, keep, spans);
+					if( !bPolygon || (0.0 >= tolerance) || !ringsMeet( &block.xs[nBasePoint], &block.ys[nBasePoint],
+							&block.partSizes[nBasePart], block.partSizes.size() - nBasePart, segments, active)) {
+						break;
+					}
+					block.xs.resize( nBasePoint);
+					block.ys.resize( nBasePoint);
+					block.partSizes.resize( nBasePart);
+					tolerance = (MAX_SIMPLIFY_RETRIES > nTry) ? (tolerance / 2.0) : 0.0;
+				}
+				block.shapeParts.push_back( block.partSizes.size() - nBasePart);
+
+				// The box of what remains
+				S_BOUNDING_BOX box = shape.getBoundingBox();
+				if( block.xs.size() > nBasePoint) {
+					box.Xmin = box.Xmax = block.xs[nBasePoint];
+					box.Ymin = box.Ymax = block.ys[nBasePoint];
+					for( size_t nPoint = nBasePoint + 1; block.xs.size() > nPoint; ++ nPoint) {
+						if( block.xs[nPoint] < box.Xmin) box.Xmin = block.xs[nPoint];
+						if( block.xs[nPoint] > box.Xmax) box.Xmax = block.xs[nPoint];
+						if( block.ys[nPoint] < box.Ymin) box.Ymin = block.ys[nPoint];
+						if( block.ys[nPoint] > box.Ymax) box.Ymax = block.ys[nPoint];
+					}
+				}
+				block.boxes.push_back( box);
+
+			}
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (rLayer.getShapeCount() + SHAPES_PER_BLOCK - 1) / SHAPES_PER_BLOCK);
+		}
+
+		// Get the simplified shapes of a block
+		const S_SIMPLE_BLOCK & getBlock( const size_t nBlock) const {
+			return( blocks[nBlock]);
+		}
+
+	protected:
+
+		// Append the parts of a shape simplified at a tolerance (every point when it is zero)
+		void addParts( const FlatShape &shape, const double tolerance, const bool bRing, S_SIMPLE_BLOCK &block,
+			std::vector<BYTE> &keep, std::vector< std::pair<size_t, size_t> > &spans) const {
+
+			// Small parts are dropped, other than the largest
+			size_t nLargest = 0;
+			double largestSize = -1.0;
+			std::vector<bool> bSmall( shape.getPartCount(), false);
+			for( size_t nPart = 0; (0.0 < tolerance) && (shape.getPartCount() > nPart); ++ nPart) {
+				const double *pX = shape.getPartX( nPart);
+				const double *pY = shape.getPartY( nPart);
+				size_t partSize = shape.getPartSize( nPart);
+				if( 0 == partSize) {
+					continue;
+				}
+				S_BOUNDING_BOX box = { pX[0], pY[0], pX[0], pY[0] };
+				for( size_t nPoint = 1; partSize > nPoint; ++ nPoint) {
+					if( pX[nPoint] < box.Xmin) box.Xmin = pX[nPoint];
+					if( pX[nPoint] > box.Xmax) box.Xmax = pX[nPoint];
+					if( pY[nPoint] < box.Ymin) box.Ymin = pY[nPoint];
+					if( pY[nPoint] > box.Ymax) box.Ymax = pY[nPoint];
+				}
+				double partWidth = box.Xmax - box.Xmin;
+				double partHeight = box.Ymax - box.Ymin;
+				bSmall[nPart] = (tolerance >= partWidth) && (tolerance >= partHeight);
+				if( std::max( partWidth, partHeight) > largestSize) {
+					largestSize = std::max( partWidth, partHeight);
+					nLargest = nPart;
+				}
+			}
+
+			for( size_t nPart = 0; shape.getPartCount() > nPart; ++ nPart) {
+				if( bSmall[nPart] && (nLargest != nPart)) {
+					continue;
+				}
+				const double *pX = shape.getPartX( nPart);
+				const double *pY = shape.getPartY( nPart);
+				size_t partSize = shape.getPartSize( nPart);
+
+				// Short parts, and every part at no tolerance, are kept whole
+				if( (0.0 >= tolerance) || ((bRing ? 4 : 2) >= partSize)) {
+					block.xs.insert( block.xs.end(), pX, pX + partSize);
+					block.ys.insert( block.ys.end(), pY, pY + partSize);
+					block.partSizes.push_back( partSize);
+					continue;
+				}
+
+				// Rings are split at the point furthest from their start, so they cannot collapse
+				keep.assign( partSize, 0);
+				keep[0] = keep[partSize - 1] = 1;
+				double tolerance2 = tolerance * tolerance;
+				if( bRing) {
+					size_t nSplit = 1;
+					double maxDistance2 = -1.0;
+					for( size_t nPoint = 1; (partSize - 1) > nPoint; ++ nPoint) {
+						double dx = pX[nPoint] - pX[0];
+						double dy = pY[nPoint] - pY[0];
+						if( ((dx * dx) + (dy * dy)) > maxDistance2) {
+							maxDistance2 = (dx * dx) + (dy * dy);
+							nSplit = nPoint;
+						}
+					}
+					keep[nSplit] = 1;
+					simplifySpan( pX, pY, 0, nSplit, tolerance2, keep, spans);
+					simplifySpan( pX, pY, nSplit, partSize - 1, tolerance2, keep, spans);
+
+					// Rings keep at least four points - the furthest remaining from its span is added
+					size_t numKept = 0;
+					for( size_t nPoint = 0; partSize > nPoint; ++ nPoint) {
+						numKept += keep[nPoint];
+					}
+					if( 4 > numKept) {
+						size_t nFirstExtra = 0;
+						size_t nSecondExtra = 0;
+						double firstDistance2 = findFurthest( pX, pY, 0, nSplit, nFirstExtra);
+						double secondDistance2 = findFurthest( pX, pY, nSplit, partSize - 1, nSecondExtra);
+						keep[(firstDistance2 >= secondDistance2) ? nFirstExtra : nSecondExtra] = 1;
+					}
+				}
+				else {
+					simplifySpan( pX, pY, 0, partSize - 1, tolerance2, keep, spans);
+				}
+
+				size_t numKept = 0;
+				for( size_t nPoint = 0; partSize > nPoint; ++ nPoint) {
+					if( keep[nPoint]) {
+						block.xs.push_back( pX[nPoint]);
+						block.ys.push_back( pY[nPoint]);
+						++ numKept;
+					}
+				}
+				block.partSizes.push_back( numKept);
+			}
+
+		}
+
+		// The layer
+		const FlatLayer &rLayer;
+
+		// The tolerance
+		double levelTolerance;
+
+		// The simplified shapes of each block
+		std::vector<S_SIMPLE_BLOCK> blocks;
+
+	};
+
+	//////////////////////
+	// LEVELS OF DETAIL //
+	//////////////////////
+
+	LevelsOfDetail::LevelsOfDetail( const FlatLayer &layer, const std::vector<double> &tolerances, const unsigned int numThreads) :
+		original(layer) {
+
+		// Each distinct positive tolerance, in order
+		std::vector<double> sorted;
+		for( size_t nTolerance = 0; tolerances.size() > nTolerance; ++ nTolerance) {
+			double tolerance = tolerances[nTolerance];
+			if( !(0.0 <= tolerance) || isinf( tolerance)) {
+				char msg[1024 + 1];
+				sprintf( msg, "Invalid simplification tolerance %g", tolerance);
+				throw( new ShapeException( std::string( msg)));
+			}
+			if( 0.0 < tolerance) {
+				sorted.push_back( tolerance);
+			}
+		}
+		std::sort( sorted.begin(), sorted.end());
+		sorted.erase( std::unique( sorted.begin(), sorted.end()), sorted.end());
+
+		// Build each level
+		try {
+			for( size_t nLevel = 0; sorted.size() > nLevel; ++ nLevel) {
+				S_DETAIL_LEVEL *pLevel = new S_DETAIL_LEVEL;
+				pLevel->tolerance = sorted[nLevel];
+				pLevel->pLayer = (FlatLayer *) 0x0;
+				levels.push_back( pLevel);
+				buildLevel( *pLevel, numThreads);
+			}
+		}
+		catch( ...) {
+			for( size_t nLevel = 0; levels.size() > nLevel; ++ nLevel) {
+				delete levels[nLevel]->pLayer;
+				delete levels[nLevel];
+			}
+			throw;
+		}
+
+	}
+
+	LevelsOfDetail::~LevelsOfDetail() {
+
+		for( size_t nLevel = 0; levels.size() > nLevel; ++ nLevel) {
+			delete levels[nLevel]->pLayer;
+			delete levels[nLevel];
+		}
+
+	}
+
+	// Simplify the layer at one tolerance
+	void LevelsOfDetail::buildLevel( S_DETAIL_LEVEL &level, const unsigned int numThreads) {
+
+		SimplifyTask task( original, level.tolerance);
+		runParallel( task, task.getBlockCount(), numThreads);
+
+		// Join the blocks
+		size_t numPoints = 0;
+		size_t numParts = 0;
+		for( size_t nBlock = 0; task.getBlockCount() > nBlock; ++ nBlock) {
+			numPoints += task.getBlock( nBlock).xs.size();
+			numParts += task.getBlock( nBlock).partSizes.size();
+		}
+		level.xs.reserve( numPoints);
+		level.ys.reserve( numPoints);
+		level.partStarts.reserve( numParts + 1);
+		level.shapeStarts.reserve( original.getShapeCount() + 1);
+		level.boxes.reserve( original.getShapeCount());
+		level.partStarts.push_back( 0);
+		level.shapeStarts.push_back( 0);
+		for( size_t nBlock = 0; task.getBlockCount() > nBlock; ++ nBlock) {
+			const S_SIMPLE_BLOCK &block = task.getBlock( nBlock);
+			level.xs.insert( level.xs.end(), block.xs.begin(), block.xs.end());
+			level.ys.insert( level.ys.end(), block.ys.begin(), block.ys.end());
+			for( size_t nPart = 0; block.partSizes.size() > nPart; ++ nPart) {
+				level.partStarts.push_back( level.partStarts.back() + block.partSizes[nPart]);
+			}
+			for( size_t nShape = 0; block.shapeParts.size() > nShape; ++ nShape) {
+				level.shapeStarts.push_back( level.shapeStarts.back() + block.shapeParts[nShape]);
+			}
+			level.boxes.insert( level.boxes.end(), block.boxes.begin(), block.boxes.end());
+		}
+
+		// The level keeps its own record numbers and shape types, so reordering the original
+		// (as sortHilbert does) cannot mismatch them with the level's shapes
+		size_t numShapes = original.getShapeCount();
+		level.recordNums.assign( original.getRecordNumbers(), original.getRecordNumbers() + numShapes);
+		level.shapeTypes.assign( original.getShapeTypes(), original.getShapeTypes() + numShapes);
+		level.pLayer = new FlatLayer( original.getShapeHeader(), numShapes, numParts, numPoints,
+			level.xs.empty() ? (const double *) 0x0 : &level.xs[0], level.ys.empty() ? (const double *) 0x0 : &level.ys[0],
+			&level.partStarts[0], &level.shapeStarts[0], level.boxes.empty() ? (const S_BOUNDING_BOX *) 0x0 : &level.boxes[0],
+			level.recordNums.empty() ? (const int *) 0x0 : &level.recordNums[0],
+			level.shapeTypes.empty() ? (const BYTE *) 0x0 : &level.shapeTypes[0]);
+
+	}
+
+	// Get the tolerance of a level
+	double LevelsOfDetail::getTolerance( const size_t nLevel) const {
+
+		if( levels.size() < nLevel) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid level %lu of %lu", nLevel, levels.size() + 1);
+			throw( new ShapeException( std::string( msg)));
+		}
+		return( (0 == nLevel) ? 0.0 : levels[nLevel - 1]->tolerance);
+
+	}
+
+	// Get a level
+	const FlatLayer & LevelsOfDetail::getLevel( const size_t nLevel) const {
+
+		if( levels.size() < nLevel) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid level %lu of %lu", nLevel, levels.size() + 1);
+			throw( new ShapeException( std::string( msg)));
+		}
+		return( (0 == nLevel) ? original : *levels[nLevel - 1]->pLayer);
+
+	}
+
+	// Find the cheapest level meeting a tolerance
+	size_t LevelsOfDetail::findLevel( const double tolerance) const {
+
+		size_t nLevel = 0;
+		while( (levels.size() > nLevel) && (levels[nLevel]->tolerance <= tolerance)) {
+			++ nLevel;
+		}
+		return( nLevel);
+
+	}
+
+};
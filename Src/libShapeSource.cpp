@@ -0,0 +1,354 @@
+//
+//  libShapeSource.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// STL includes
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Project includes
+#include <libShapeSource.hpp>
+#include <libShapeFile.hpp>
+
+namespace libShape {
+
+	//////////////////
+	// INPUT SOURCE //
+	//////////////////
+
+	InputSource::InputSource() {
+
+	}
+
+	InputSource::~InputSource() {
+
+	}
+
+	// Keep reading until satisfied or the input ends
+	size_t InputSource::readFully( BYTE *pBuffer, const size_t bufSize) {
+
+		size_t tTotal = 0;
+		while( bufSize > tTotal) {
+			size_t tRead = read( pBuffer + tTotal, bufSize - tTotal);
+			if( 0 == tRead) break;
+			tTotal += tRead;
+		}
+		return( tTotal);
+
+	}
+
+	/////////////////
+	// FILE SOURCE //
+	/////////////////
+
+	FileSource::FileSource( FILE *fFile) : fileInput(fFile) {
+
+		// Error?
+		if( (FILE *) 0x0 == fFile) {
+			throw( new ShapeException( std::string("NULL input file")));
+		}
+
+	}
+
+	FileSource::~FileSource() {
+
+	}
+
+	size_t FileSource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		size_t tRead = fread( pBuffer, sizeof(BYTE), bufSize, fileInput);
+		if( (0 == tRead) && ferror( fileInput)) {
+			throw( new ShapeException( std::string("Error reading from input file")));
+		}
+		return( tRead);
+
+	}
+
+	//////////////////
+	// BLOCK SOURCE //
+	//////////////////
+
+	BlockSource::BlockSource( InputSource &source, const size_t blockSize) : input(source), blockFill(0), blockPos(0) {
+
+		// Error?
+		if( 0 == blockSize) {
+			throw( new ShapeException( std::string("Zero block size")));
+		}
+		block.resize( blockSize);
+
+	}
+
+	BlockSource::~BlockSource() {
+
+	}
+
+	size_t BlockSource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		// Refill an empty block - unless the read would take all of it anyway
+		if( blockFill == blockPos) {
+			if( block.size() <= bufSize) {
+				return( input.read( pBuffer, bufSize));
+			}
+			blockFill = input.readFully( &block[0], block.size());
+			blockPos = 0;
+		}
+
+		// Serve from the block
+		size_t tCopy = blockFill - blockPos;
+		if( bufSize < tCopy) tCopy = bufSize;
+		if( 0 != tCopy) {
+			memcpy( pBuffer, &block[blockPos], tCopy);
+			blockPos += tCopy;
+		}
+		return( tCopy);
+
+	}
+
+	///////////////////////
+	// READ AHEAD SOURCE //
+	///////////////////////
+
+	// The ring shared by the reader and the I/O thread
+	//
+	// Buffers [nFirstFull, nFirstFull + numFull) of the ring are filled and
+	// belong to the reader, the rest belong to the I/O thread
+	struct s_read_ahead {
+		std::vector< std::vector<BYTE> > buffers;
+		std::vector<size_t> fills;
+		size_t nFirstFull;
+		size_t numFull;
+		bool bEnded;
+		bool bStopping;
+		std::exception_ptr error;
+		std::mutex lock;
+		std::condition_variable changed;
+		std::thread ioThread;
+
+		// The reader's place in the first full buffer
+		size_t readPos;
+	};
+
+	ReadAheadSource::ReadAheadSource( InputSource &source, const size_t numBuffers, const size_t bufferSize) :
+		pFileSource( (FileSource *) 0x0), input(source), pState( (S_READ_AHEAD *) 0x0) {
+
+		start( numBuffers, bufferSize);
+
+	}
+
+	ReadAheadSource::ReadAheadSource( FILE *fFile, const size_t numBuffers, const size_t bufferSize) :
+		pFileSource( new FileSource( fFile)), input(*pFileSource), pState( (S_READ_AHEAD *) 0x0) {
+
+		// Let the system read ahead too
+#if defined( POSIX_FADV_SEQUENTIAL)
+		posix_fadvise( fileno( fFile), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+		try {
+			start( numBuffers, bufferSize);
+		}
+		catch( ...) {
+			delete pFileSource;
+			throw;
+		}
+
+	}
+
+	ReadAheadSource::~ReadAheadSource() {
+
+		// Stop the I/O thread - it finishes any read under way first
+		{
+			std::lock_guard<std::mutex> guard( pState -> lock);
+			pState -> bStopping = true;
+		}
+		pState -> changed.notify_all();
+		pState -> ioThread.join();
+		delete pState;
+		delete pFileSource;
+
+	}
+
+	// Size the ring and start the I/O thread
+	void ReadAheadSource::start( const size_t numBuffers, const size_t bufferSize) {
+
+		// Error?
+		if( (0 == numBuffers) || (0 == bufferSize)) {
+			throw( new ShapeException( std::string("Read ahead needs at least one buffer of at least one byte")));
+		}
+
+		// The state is freed if the ring or the thread cannot be had, as the destructor will not run
+		pState = new S_READ_AHEAD();
+		try {
+			pState -> buffers.resize( numBuffers, std::vector<BYTE>( bufferSize));
+			pState -> fills.resize( numBuffers, 0);
+			pState -> nFirstFull = 0;
+			pState -> numFull = 0;
+			pState -> bEnded = false;
+			pState -> bStopping = false;
+			pState -> readPos = 0;
+			pState -> ioThread = std::thread( &ReadAheadSource::fillBuffers, this);
+		}
+		catch( ...) {
+			delete pState;
+			pState = (S_READ_AHEAD *) 0x0;
+			throw;
+		}
+
+	}
+
+	// The I/O thread - fill free buffers until the input ends
+	void ReadAheadSource::fillBuffers() {
+
+		S_READ_AHEAD &state = *pState;
+		size_t numBuffers = state.buffers.size();
+		while( true) {
+
+			// Wait for a free buffer
+			size_t nBuffer = 0;
+			{
+				std::unique_lock<std::mutex> guard( state.lock);
+				while( !state.bStopping && (numBuffers == state.numFull)) {
+					state.changed.wait( guard);
+				}
+				if( state.bStopping) {
+					return;
+				}
+				nBuffer = (state.nFirstFull + state.numFull) % numBuffers;
+			}
+
+			// Fill it outside the lock
+			size_t tRead = 0;
+			std::exception_ptr error;
+			try {
+				tRead = input.readFully( &state.buffers[nBuffer][0], state.buffers[nBuffer].size());
+			}
+			catch( ...) {
+				error = std::current_exception();
+			}
+
+			// Hand it over - a short buffer is the last
+			bool bEnded = (error || (tRead < state.buffers[nBuffer].size()));
+			{
+				std::lock_guard<std::mutex> guard( state.lock);
+				state.fills[nBuffer] = tRead;
+				if( 0 != tRead) {
+					++ state.numFull;
+				}
+				state.error = error;
+				state.bEnded = bEnded;
+			}
+			state.changed.notify_all();
+			if( bEnded) {
+				return;
+			}
+
+		}
+
+	}
+
+	size_t ReadAheadSource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		S_READ_AHEAD &state = *pState;
+		size_t numBuffers = state.buffers.size();
+		std::unique_lock<std::mutex> guard( state.lock);
+
+		// Wait for a full buffer, or the end
+		while( (0 == state.numFull) && !state.bEnded) {
+			state.changed.wait( guard);
+		}
+		if( 0 == state.numFull) {
+			if( state.error) {
+				std::rethrow_exception( state.error);
+			}
+			return( 0);
+		}
+
+		// The buffer stays the reader's while it is read, so copy outside the lock
+		size_t nBuffer = state.nFirstFull;
+		guard.unlock();
+		size_t tCopy = state.fills[nBuffer] - state.readPos;
+		if( bufSize < tCopy) tCopy = bufSize;
+		memcpy( pBuffer, &state.buffers[nBuffer][state.readPos], tCopy);
+		state.readPos += tCopy;
+
+		// Hand back a finished buffer
+		if( state.fills[nBuffer] == state.readPos) {
+			guard.lock();
+			state.nFirstFull = (state.nFirstFull + 1) % numBuffers;
+			-- state.numFull;
+			state.readPos = 0;
+			guard.unlock();
+			state.changed.notify_all();
+		}
+		return( tCopy);
+
+	}
+
+	///////////////////
+	// MEMORY SOURCE //
+	///////////////////
+
+	MemorySource::MemorySource( const BYTE *pData, const size_t dataSize) : pImage(pData), imageSize(dataSize), curPos(0) {
+
+		// Error?
+		if( ((const BYTE *) 0x0 == pData) && (0 != dataSize)) {
+			throw( new ShapeException( std::string("NULL input image")));
+		}
+
+	}
+
+	MemorySource::~MemorySource() {
+
+	}
+
+	size_t MemorySource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		size_t tCopy = imageSize - curPos;
+		if( bufSize < tCopy) tCopy = bufSize;
+		if( 0 != tCopy) {
+			memcpy( pBuffer, pImage + curPos, tCopy);
+			curPos += tCopy;
+		}
+		return( tCopy);
+
+	}
+
+};
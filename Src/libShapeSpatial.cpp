@@ -0,0 +1,863 @@
+//
+//  libShapeSpatial.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// STL includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+// Project includes
+#include <libShapePrepared.hpp>
+#include <libShapeSpatial.hpp>
+#include <libShapeThreads.hpp>
+
+namespace libShape {
+
+	/////////////
+	// HELPERS //
+	/////////////
+
+	// Order nodes by the center of their box
+	static bool lessCenterX( const S_RTREE_NODE &left, const S_RTREE_NODE &right) {
+		return( (left.box.Xmin + left.box.Xmax) < (right.box.Xmin + right.box.Xmax));
+	}
+	static bool lessCenterY( const S_RTREE_NODE &left, const S_RTREE_NODE &right) {
+		return( (left.box.Ymin + left.box.Ymax) < (right.box.Ymin + right.box.Ymax));
+	}
+
+	// Sort-Tile-Recursive ordering of a level - vertical slices by x, each sorted by y
+	static void sortTiles( CNT_RTREE_NODES::iterator itrBegin, CNT_RTREE_NODES::iterator itrEnd, const size_t nodeSize) {
+
+		size_t numNodes = itrEnd - itrBegin;
+		size_t numParents = (numNodes + nodeSize - 1) / nodeSize;
+		size_t numSlices = (size_t) ceil( sqrt( (double) numParents));
+		size_t sliceSize = nodeSize * ((numParents + numSlices - 1) / numSlices);
+
+		std::sort( itrBegin, itrEnd, lessCenterX);
+		for( size_t nStart = 0; numNodes > nStart; nStart += sliceSize) {
+			size_t nEnd = std::min( numNodes, nStart + sliceSize);
+			std::sort( itrBegin + nStart, itrBegin + nEnd, lessCenterY);
+		}
+
+	}
+
+	// Grow a box to cover another
+	static void expandBox( S_BOUNDING_BOX &box, const S_BOUNDING_BOX &other) {
+		if( other.Xmin < box.Xmin) box.Xmin = other.Xmin;
+		if( other.Ymin < box.Ymin) box.Ymin = other.Ymin;
+		if( other.Xmax > box.Xmax) box.Xmax = other.Xmax;
+		if( other.Ymax > box.Ymax) box.Ymax = other.Ymax;
+	}
+
+	// See if two boxes overlap, edges included
+	static bool boxesOverlap( const S_BOUNDING_BOX &left, const S_BOUNDING_BOX &right) {
+		return( (left.Xmin <= right.Xmax) && (right.Xmin <= left.Xmax) &&
+			(left.Ymin <= right.Ymax) && (right.Ymin <= left.Ymax));
+	}
+
+	// Squared distance from a point to a box - zero inside
+	static double boxDistance2( const S_BOUNDING_BOX &box, const double x, const double y) {
+		double dx = (x < box.Xmin) ? (box.Xmin - x) : ((x > box.Xmax) ? (x - box.Xmax) : 0.0);
+		double dy = (y < box.Ymin) ? (box.Ymin - y) : ((y > box.Ymax) ? (y - box.Ymax) : 0.0);
+		return( (dx * dx) + (dy * dy));
+	}
+
+	// Only shapes with geometry are indexed
+	static bool hasExtent( const E_SHAPE_TYPE eShapeType) {
+		return( (SHAPE_NULL != eShapeType) && (SHAPE_INVALID != eShapeType));
+	}
+
+	//////////////////
+	// SHAPE R-TREE //
+	//////////////////
+
+	const size_t ShapeRTree::DEFAULT_NODE_SIZE = 16;
+
+	ShapeRTree::ShapeRTree( const CNT_SHAPES &shapes, const size_t nodeSize) :
+		nItems( 0), pNodes( (const S_RTREE_NODE *) 0x0), numNodes( 0), pShapes( &shapes), pLayer( (const FlatLayer *) 0x0) {
+
+		nodes.reserve( shapes.size() + (shapes.size() / 2) + 1);
+		for( size_t nIndex = 0; shapes.size() > nIndex; ++ nIndex) {
+			const AbstractShape *pShape = shapes[nIndex];
+			if( ((AbstractShape *) 0x0 != pShape) && hasExtent( pShape->getShapeType())) {
+				S_RTREE_NODE entry = { pShape->getBoundingBox(), nIndex, 0 };
+				nodes.push_back( entry);
+			}
+		}
+		build( nodeSize);
+
+	}
+
+	ShapeRTree::ShapeRTree( const FlatLayer &layer, const size_t nodeSize) :
+		nItems( 0), pNodes( (const S_RTREE_NODE *) 0x0), numNodes( 0), pShapes( (const CNT_SHAPES *) 0x0), pLayer( &layer) {
+
+		nodes.reserve( layer.getShapeCount() + (layer.getShapeCount() / 2) + 1);
+		for( size_t nIndex = 0; layer.getShapeCount() > nIndex; ++ nIndex) {
+			if( hasExtent( layer.getShapeType( nIndex))) {
+				S_RTREE_NODE entry = { layer.getBoundingBox( nIndex), nIndex, 0 };
+				nodes.push_back( entry);
+			}
+		}
+		build( nodeSize);
+
+	}
+
+	ShapeRTree::ShapeRTree( const S_BOUNDING_BOX *pBoxes, const size_t numBoxes, const size_t nodeSize) :
+		nItems( 0), pNodes( (const S_RTREE_NODE *) 0x0), numNodes( 0), pShapes( (const CNT_SHAPES *) 0x0), pLayer( (const FlatLayer *) 0x0) {
+
+		// Error?
+		if( ((const S_BOUNDING_BOX *) 0x0 == pBoxes) && (0 < numBoxes)) {
+			throw( new ShapeException( std::string( "NULL bounding box array")));
+		}
+
+		nodes.reserve( numBoxes + (numBoxes / 2) + 1);
+		for( size_t nIndex = 0; numBoxes > nIndex; ++ nIndex) {
+			S_RTREE_NODE entry = { pBoxes[nIndex], nIndex, 0 };
+			nodes.push_back( entry);
+		}
+		build( nodeSize);
+
+	}
+
+	ShapeRTree::ShapeRTree( const FlatLayer &layer, const S_RTREE_NODE *pNodeArray, const size_t numNodeArray, const size_t numItems) :
+		nItems( numItems), pNodes( pNodeArray), numNodes( numNodeArray), pShapes( (const CNT_SHAPES *) 0x0), pLayer( &layer) {
+
+		// Error?
+		if( ((const S_RTREE_NODE *) 0x0 == pNodeArray) && (0 < numNodeArray)) {
+			throw( new ShapeException( std::string( "NULL R-tree node array")));
+		}
+		if( (numItems > numNodeArray) || ((0 == numItems) != (0 == numNodeArray))) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid R-tree of %lu items in %lu nodes", numItems, numNodeArray);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+	}
+
+	ShapeRTree::~ShapeRTree() {
+
+	}
+
+	void ShapeRTree::build( const size_t nodeSize) {
+
+		// Error?
+		if( 2 > nodeSize) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid R-tree node size %lu", nodeSize);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Order the leaf entries
+		nItems = nodes.size();
+		if( 0 == nItems) {
+			attachNodes();
+			return;
+		}
+		sortTiles( nodes.begin(), nodes.end(), nodeSize);
+
+		// Pack each level into the one above, until a single root remains
+		size_t nLevelStart = 0;
+		size_t nLevelEnd = nItems;
+		while( 1 < (nLevelEnd - nLevelStart)) {
+
+			for( size_t nChild = nLevelStart; nLevelEnd > nChild; nChild += nodeSize) {
+				S_RTREE_NODE parent;
+				parent.box = nodes[nChild].box;
+				parent.nFirst = nChild;
+				parent.nCount = std::min( nodeSize, nLevelEnd - nChild);
+				for( size_t nNext = 1; parent.nCount > nNext; ++ nNext) {
+					expandBox( parent.box, nodes[nChild + nNext].box);
+				}
+				nodes.push_back( parent);
+			}
+
+			// The parents keep their child ranges, so may be reordered in turn
+			nLevelStart = nLevelEnd;
+			nLevelEnd = nodes.size();
+			sortTiles( nodes.begin() + nLevelStart, nodes.end(), nodeSize);
+
+		}
+		attachNodes();
+
+	}
+
+	void ShapeRTree::attachNodes() {
+
+		pNodes = nodes.empty() ? (const S_RTREE_NODE *) 0x0 : &nodes[0];
+		numNodes = nodes.size();
+
+	}
+
+	S_BOUNDING_BOX ShapeRTree::getBounds() const {
+
+		S_BOUNDING_BOX box;
+		memset( &box, 0x0, sizeof( box));
+		if( 0 < numNodes) {
+			box = pNodes[numNodes - 1].box;
+		}
+		return( box);
+
+	}
+
+	void ShapeRTree::searchBox( const size_t nNode, const S_BOUNDING_BOX &box, std::vector<size_t> &results) const {
+
+		const S_RTREE_NODE &node = pNodes[nNode];
+		if( !boxesOverlap( node.box, box)) {
+			return;
+		}
+		if( nItems > nNode) {
+			results.push_back( node.nFirst);
+			return;
+		}
+		for( size_t nChild = node.nFirst; (node.nFirst + node.nCount) > nChild; ++ nChild) {
+			searchBox( nChild, box, results);
+		}
+
+	}
+
+	size_t ShapeRTree::queryBox( const S_BOUNDING_BOX &box, std::vector<size_t> &results) const {
+
+		size_t nBefore = results.size();
+		if( 0 < numNodes) {
+			searchBox( numNodes - 1, box, results);
+		}
+		return( results.size() - nBefore);
+
+	}
+
+	size_t ShapeRTree::queryPoint( const double x, const double y, std::vector<size_t> &results) const {
+
+		S_BOUNDING_BOX box = { x, y, x, y };
+		return( queryBox( box, results));
+
+	}
+
+	void ShapeRTree::searchShapes( const size_t nNode, const S_BOUNDING_BOX &box, CNT_SHAPES &results) const {
+
+		const S_RTREE_NODE &node = pNodes[nNode];
+		if( !boxesOverlap( node.box, box)) {
+			return;
+		}
+		if( nItems > nNode) {
+			results.push_back( (*pShapes)[node.nFirst]);
+			return;
+		}
+		for( size_t nChild = node.nFirst; (node.nFirst + node.nCount) > nChild; ++ nChild) {
+			searchShapes( nChild, box, results);
+		}
+
+	}
+
+	size_t ShapeRTree::queryPoint( const double x, const double y, CNT_SHAPES &results) const {
+
+		// Error?
+		if( (const CNT_SHAPES *) 0x0 == pShapes) {
+			throw( new ShapeException( std::string( "R-tree was not built over decoded shapes")));
+		}
+
+		size_t nBefore = results.size();
+		if( 0 < numNodes) {
+			S_BOUNDING_BOX box = { x, y, x, y };
+			searchShapes( numNodes - 1, box, results);
+		}
+		return( results.size() - nBefore);
+
+	}
+
+	void ShapeRTree::searchNearest( const size_t nNode, const double x, const double y, double &bestDistance2, long &nBest) const {
+
+		// Branch and bound - skip anything further than the best so far
+		const S_RTREE_NODE &node = pNodes[nNode];
+		double distance2 = boxDistance2( node.box, x, y);
+		if( (0 <= nBest) && (distance2 > bestDistance2)) {
+			return;
+		}
+		if( nItems > nNode) {
+			if( (0 > nBest) || (distance2 < bestDistance2) || ((long) node.nFirst < nBest)) {
+				bestDistance2 = distance2;
+				nBest = node.nFirst;
+			}
+			return;
+		}
+
+		// Visit the children nearest first, so the bound tightens early - they are sorted on the
+		// stack a run at a time, as nodes may have any number of children
+		const size_t RUN_SIZE = 64;
+		double distances[RUN_SIZE];
+		size_t children[RUN_SIZE];
+		size_t nEnd = node.nFirst + node.nCount;
+		for( size_t nStart = node.nFirst; nEnd > nStart; nStart += RUN_SIZE) {
+
+			// Insertion sort the run by distance, keeping storage order on a tie
+			size_t numRun = std::min( RUN_SIZE, nEnd - nStart);
+			for( size_t nRun = 0; numRun > nRun; ++ nRun) {
+				double childDistance2 = boxDistance2( pNodes[nStart + nRun].box, x, y);
+				size_t nSlot = nRun;
+				for( ; (0 < nSlot) && (childDistance2 < distances[nSlot - 1]); -- nSlot) {
+					distances[nSlot] = distances[nSlot - 1];
+					children[nSlot] = children[nSlot - 1];
+				}
+				distances[nSlot] = childDistance2;
+				children[nSlot] = nStart + nRun;
+			}
+
+			// And search, until the rest of the run is too far away
+			for( size_t nRun = 0; numRun > nRun; ++ nRun) {
+				if( (0 <= nBest) && (distances[nRun] > bestDistance2)) {
+					break;
+				}
+				searchNearest( children[nRun], x, y, bestDistance2, nBest);
+			}
+
+		}
+
+	}
+
+	bool ShapeRTree::queryNearest( const double x, const double y, size_t &nIndex, double *pDistance) const {
+
+		// Empty?
+		if( 0 == numNodes) {
+			return( false);
+		}
+
+		double bestDistance2 = 0.0;
+		long nBest = -1;
+		searchNearest( numNodes - 1, x, y, bestDistance2, nBest);
+		nIndex = nBest;
+		if( (double *) 0x0 != pDistance) {
+			*pDistance = sqrt( bestDistance2);
+		}
+		return( true);
+
+	}
+
+	bool ShapeRTree::itemContains( const size_t nIndex, const double x, const double y) const {
+
+		if( (const CNT_SHAPES *) 0x0 != pShapes) {
+			return( (*pShapes)[nIndex]->containsPoint( x, y));
+		}
+		return( pLayer->getShape( nIndex).containsPoint( x, y));
+
+	}
+
+	long ShapeRTree::searchContaining( const size_t nNode, const double x, const double y, long nBest) const {
+
+		const S_RTREE_NODE &node = pNodes[nNode];
+		if( (x < node.box.Xmin) || (x > node.box.Xmax) || (y < node.box.Ymin) || (y > node.box.Ymax)) {
+			return( nBest);
+		}
+		if( nItems > nNode) {
+			if( ((0 > nBest) || ((long) node.nFirst < nBest)) && itemContains( node.nFirst, x, y)) {
+				nBest = node.nFirst;
+			}
+			return( nBest);
+		}
+		for( size_t nChild = node.nFirst; (node.nFirst + node.nCount) > nChild; ++ nChild) {
+			nBest = searchContaining( nChild, x, y, nBest);
+		}
+		return( nBest);
+
+	}
+
+	long ShapeRTree::findContaining( const double x, const double y) const {
+
+		// Error?
+		if( ((const CNT_SHAPES *) 0x0 == pShapes) && ((const FlatLayer *) 0x0 == pLayer)) {
+			throw( new ShapeException( std::string( "R-tree was not built over shapes")));
+		}
+
+		if( 0 == numNodes) {
+			return( -1);
+		}
+		return( searchContaining( numNodes - 1, x, y, -1));
+
+	}
+
+	int ShapeRTree::getRecordNumber( const size_t nIndex) const {
+
+		if( (const CNT_SHAPES *) 0x0 != pShapes) {
+			return( (*pShapes)[nIndex]->getRecordNumber());
+		}
+		if( (const FlatLayer *) 0x0 != pLayer) {
+			return( pLayer->getRecordNumber( nIndex));
+		}
+		throw( new ShapeException( std::string( "R-tree was not built over shapes")));
+
+	}
+
+	//////////////////////////
+	// POINT CLASSIFICATION //
+	//////////////////////////
+
+	// Spread the low 16 bits of a value to the even bits
+	static std::uint32_t spreadBits( std::uint32_t nValue) {
+		nValue &= 0x0000FFFF;
+		nValue = (nValue | (nValue << 8)) & 0x00FF00FF;
+		nValue = (nValue | (nValue << 4)) & 0x0F0F0F0F;
+		nValue = (nValue | (nValue << 2)) & 0x33333333;
+		nValue = (nValue | (nValue << 1)) & 0x55555555;
+		return( nValue);
+	}
+
+	// Classify a batch of points, one block at a time
+	class PointClassifyTask : public ParallelTask {
+
+	public:
+
+		// The number of points in each block - their order takes 128KB of stack
+		const static size_t POINTS_PER_BLOCK = 65536;
+
+		// Construction
+		PointClassifyTask( const ShapeRTree &tree, const double *pX, const double *pY, const size_t numPoints, int *pRecordNums) :
+			rTree(tree), pXs(pX), pYs(pY), nPoints(numPoints), pResults(pRecordNums) {
+
+			// Scale coordinates within the tree bounds onto a 16 bit grid
+			bounds = tree.getBounds();
+			double width = bounds.Xmax - bounds.Xmin;
+			double height = bounds.Ymax - bounds.Ymin;
+			scaleX = (0.0 < width) ? (65535.0 / width) : 0.0;
+			scaleY = (0.0 < height) ? (65535.0 / height) : 0.0;
+
+		}
+
+		// Destruction
+		virtual ~PointClassifyTask() {
+		}
+
+		// Classify one block of points
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * POINTS_PER_BLOCK;
+			size_t nLast = nFirst + POINTS_PER_BLOCK;
+			if( nPoints < nLast) nLast = nPoints;
+
+			// Order the block along a Z curve, so neighbouring points share tree paths and shapes
+			// The keys are held in the results until each point is classified, and the order on
+			// the stack, so classifying allocates nothing
+			std::uint16_t order[POINTS_PER_BLOCK];
+			size_t numOrder = nLast - nFirst;
+			std::uint32_t *pKeys = (std::uint32_t *) (pResults + nFirst);
+			for( size_t nOrder = 0; numOrder > nOrder; ++ nOrder) {
+				pKeys[nOrder] = getKey( pXs[nFirst + nOrder], pYs[nFirst + nOrder]);
+				order[nOrder] = (std::uint16_t) nOrder;
+			}
+			std::sort( order, order + numOrder, KeyOrder( pKeys));
+
+			// And classify
+			for( size_t nOrder = 0; numOrder > nOrder; ++ nOrder) {
+				size_t nPoint = nFirst + order[nOrder];
+				long nFound = rTree.findContaining( pXs[nPoint], pYs[nPoint]);
+				pResults[nPoint] = (0 > nFound) ? -1 : rTree.getRecordNumber( nFound);
+			}
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (nPoints + POINTS_PER_BLOCK - 1) / POINTS_PER_BLOCK);
+		}
+
+	protected:
+
+		// Order points by their keys
+		struct KeyOrder {
+			KeyOrder( const std::uint32_t *pKeyArray) : pKeys(pKeyArray) { }
+			bool operator()( const std::uint16_t nLeft, const std::uint16_t nRight) const { return( pKeys[nLeft] < pKeys[nRight]); }
+			const std::uint32_t *pKeys;
+		};
+
+		// Get the Z curve key of a point - points outside the bounds are clamped
+		std::uint32_t getKey( const double x, const double y) const {
+			double gridX = (x - bounds.Xmin) * scaleX;
+			double gridY = (y - bounds.Ymin) * scaleY;
+			std::uint32_t nX = (0.0 < gridX) ? ((65535.0 < gridX) ? 65535 : (std::uint32_t) gridX) : 0;
+			std::uint32_t nY = (0.0 < gridY) ? ((65535.0 < gridY) ? 65535 : (std::uint32_t) gridY) : 0;
+			return( spreadBits( nX) | (spreadBits( nY) << 1));
+		}
+
+		// The tree
+		const ShapeRTree &rTree;
+
+		// The points
+		const double *pXs;
+		const double *pYs;
+		size_t nPoints;
+
+		// The results
+		int *pResults;
+
+		// The grid
+		S_BOUNDING_BOX bounds;
+		double scaleX;
+		double scaleY;
+
+	};
+
+	void classifyPoints( const ShapeRTree &tree, const double *pX, const double *pY, const size_t numPoints,
+		int *pRecordNums, const unsigned int numThreads) {
+
+		// Error?
+		if( (0 < numPoints) && (((const double *) 0x0 == pX) || ((const double *) 0x0 == pY) || ((int *) 0x0 == pRecordNums))) {
+			throw( new ShapeException( std::string( "NULL point or result array")));
+		}
+
+		PointClassifyTask task( tree, pX, pY, numPoints, pRecordNums);
+		runParallel( task, task.getBlockCount(), numThreads);
+
+	}
+
+	//////////////////
+	// SPATIAL JOIN //
+	//////////////////
+
+	JoinVisitor::JoinVisitor() {
+
+	}
+
+	JoinVisitor::~JoinVisitor() {
+
+	}
+
+	// The most bits of each Z curve coordinate used to partition points
+	static const int JOIN_MAX_GRID_BITS = 10;
+
+	// The number of points to aim for in each partition
+	static const size_t JOIN_PARTITION_POINTS = 4096;
+
+	// Partitions overlapping more polygons than this index them in a tree of their own
+	static const size_t JOIN_LOCAL_TREE_SIZE = 16;
+
+	// A point to join
+	struct s_join_point {
+		double x;
+		double y;
+		int recordNum;
+	};
+	typedef struct s_join_point S_JOIN_POINT;
+
+	// Prepare the polygons to join, one block at a time
+	class PolygonPrepareTask : public ParallelTask {
+
+	public:
+
+		// The number of polygons in each block
+		const static size_t POLYGONS_PER_BLOCK = 64;
+
+		// Construction
+		PolygonPrepareTask( const CNT_SHAPES &polygons, std::vector<PreparedPolygon *> &prepared) :
+			rPolygons(polygons), rPrepared(prepared) {
+		}
+
+		// Destruction
+		virtual ~PolygonPrepareTask() {
+		}
+
+		// Prepare one block of polygons - other shapes are tested as they are
+		virtual void runBlock( const size_t nBlock) {
+
+			size_t nFirst = nBlock * POLYGONS_PER_BLOCK;
+			size_t nLast = nFirst + POLYGONS_PER_BLOCK;
+			if( rPolygons.size() < nLast) nLast = rPolygons.size();
+			for( size_t nPolygon = nFirst; nLast > nPolygon; ++ nPolygon) {
+				const ShapePolygon *pPolygon = dynamic_cast<const ShapePolygon *>( rPolygons[nPolygon]);
+				const FlatShape *pFlat = dynamic_cast<const FlatShape *>( rPolygons[nPolygon]);
+				if( (const ShapePolygon *) 0x0 != pPolygon) {
+					rPrepared[nPolygon] = new PreparedPolygon( *pPolygon);
+				}
+				else if( ((const FlatShape *) 0x0 != pFlat) && (SHAPE_POLYGON == pFlat->getShapeType())) {
+					rPrepared[nPolygon] = new PreparedPolygon( *pFlat);
+				}
+			}
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( (rPolygons.size() + POLYGONS_PER_BLOCK - 1) / POLYGONS_PER_BLOCK);
+		}
+
+	protected:
+
+		// The polygons
+		const CNT_SHAPES &rPolygons;
+
+		// The prepared polygons, by position
+		std::vector<PreparedPolygon *> &rPrepared;
+
+	};
+
+	// Join the points of one partition at a time
+	class PointJoinTask : public ParallelTask {
+
+	public:
+
+		// Construction
+		PointJoinTask( const std::vector<S_JOIN_POINT> &points, const std::vector<size_t> &partitionStarts,
+			const ShapeRTree &tree, const CNT_SHAPES &polygons, const std::vector<PreparedPolygon *> &prepared, JoinVisitor &visitor) :
+			rPoints(points), rStarts(partitionStarts), rTree(tree), rPolygons(polygons), rPrepared(prepared),
+			rVisitor(visitor), bStopped(false), numVisited(0) {
+		}
+
+		// Destruction
+		virtual ~PointJoinTask() {
+		}
+
+		// Join one partition
+		virtual void runBlock( const size_t nBlock) {
+
+			if( bStopped.load()) {
+				return;
+			}
+
+			// The extent of the partition, and the polygons that may hold its points
+			size_t nFirst = rStarts[nBlock];
+			size_t nLast = rStarts[nBlock + 1];
+			S_BOUNDING_BOX box = { rPoints[nFirst].x, rPoints[nFirst].y, rPoints[nFirst].x, rPoints[nFirst].y };
+			for( size_t nPoint = nFirst + 1; nLast > nPoint; ++ nPoint) {
+				const S_JOIN_POINT &point = rPoints[nPoint];
+				if( point.x < box.Xmin) box.Xmin = point.x;
+				if( point.x > box.Xmax) box.Xmax = point.x;
+				if( point.y < box.Ymin) box.Ymin = point.y;
+				if( point.y > box.Ymax) box.Ymax = point.y;
+			}
+			std::vector<size_t> candidates;
+			rTree.queryBox( box, candidates);
+			if( candidates.empty()) {
+				return;
+			}
+			std::sort( candidates.begin(), candidates.end());
+
+			// Many candidates get a tree of their own
+			std::vector<S_BOUNDING_BOX> boxes( candidates.size());
+			for( size_t nCandidate = 0; candidates.size() > nCandidate; ++ nCandidate) {
+				boxes[nCandidate] = rPolygons[candidates[nCandidate]]->getBoundingBox();
+			}
+			ShapeRTree *pLocalTree = (ShapeRTree *) 0x0;
+			if( JOIN_LOCAL_TREE_SIZE < candidates.size()) {
+				pLocalTree = new ShapeRTree( &boxes[0], boxes.size());
+			}
+
+			// Filter each point by box, then test exactly
+			std::vector< std::pair<int, int> > pairs;
+			std::vector<size_t> hits;
+			try {
+				for( size_t nPoint = nFirst; nLast > nPoint; ++ nPoint) {
+					const S_JOIN_POINT &point = rPoints[nPoint];
+					hits.clear();
+					if( (ShapeRTree *) 0x0 != pLocalTree) {
+						pLocalTree->queryPoint( point.x, point.y, hits);
+						std::sort( hits.begin(), hits.end());
+					}
+					else {
+						S_BOUNDING_BOX pointBox = { point.x, point.y, point.x, point.y };
+						for( size_t nCandidate = 0; boxes.size() > nCandidate; ++ nCandidate) {
+							if( boxesOverlap( boxes[nCandidate], pointBox)) {
+								hits.push_back( nCandidate);
+							}
+						}
+					}
+					for( size_t nHit = 0; hits.size() > nHit; ++ nHit) {
+						size_t nPolygon = candidates[hits[nHit]];
+						const AbstractShape *pTester = rPrepared[nPolygon];
+						if( (const AbstractShape *) 0x0 == pTester) {
+							pTester = rPolygons[nPolygon];
+						}
+						if( pTester->containsPoint( point.x, point.y)) {
+							pairs.push_back( std::make_pair( point.recordNum, rPolygons[nPolygon]->getRecordNumber()));
+						}
+					}
+				}
+			}
+			catch( ...) {
+				delete pLocalTree;
+				throw;
+			}
+			delete pLocalTree;
+
+			// Hand the pairs over
+			std::lock_guard<std::mutex> lock( visitLock);
+			for( size_t nPair = 0; (pairs.size() > nPair) && !bStopped.load(); ++ nPair) {
+				++ numVisited;
+				if( !rVisitor.visitPair( pairs[nPair].first, pairs[nPair].second)) {
+					bStopped.store( true);
+				}
+			}
+
+		}
+
+		// Get the number of blocks
+		size_t getBlockCount() const {
+			return( rStarts.size() - 1);
+		}
+
+		// Get the number of pairs visited
+		size_t getVisitedCount() const {
+			return( numVisited);
+		}
+
+	protected:
+
+		// The points, in partition order
+		const std::vector<S_JOIN_POINT> &rPoints;
+
+		// The first point of each partition, plus one past the end of the last
+		const std::vector<size_t> &rStarts;
+
+		// The polygons, their tree, and their prepared forms
+		const ShapeRTree &rTree;
+		const CNT_SHAPES &rPolygons;
+		const std::vector<PreparedPolygon *> &rPrepared;
+
+		// The visitor, and its lock
+		JoinVisitor &rVisitor;
+		std::mutex visitLock;
+
+		// Has the visitor stopped the join?
+		std::atomic<bool> bStopped;
+
+		// The number of pairs visited
+		size_t numVisited;
+
+	};
+
+	size_t joinPointsToPolygons( const CNT_SHAPES &points, const CNT_SHAPES &polygons, JoinVisitor &visitor,
+		const unsigned int numThreads) {
+
+		// Gather the points, and their extent - points without finite coordinates fall in no polygon
+		std::vector<S_JOIN_POINT> gathered;
+		gathered.reserve( points.size());
+		S_BOUNDING_BOX extent;
+		memset( &extent, 0x0, sizeof( extent));
+		for( size_t nShape = 0; points.size() > nShape; ++ nShape) {
+			const AbstractShape *pShape = points[nShape];
+			if( ((const AbstractShape *) 0x0 == pShape) || (SHAPE_POINT != pShape->getShapeType())) {
+				continue;
+			}
+			const S_BOUNDING_BOX &box = pShape->getBoundingBox();
+			if( !(isfinite( box.Xmin) && isfinite( box.Ymin))) {
+				continue;
+			}
+			S_JOIN_POINT point = { box.Xmin, box.Ymin, pShape->getRecordNumber() };
+			if( gathered.empty() || (point.x < extent.Xmin)) extent.Xmin = point.x;
+			if( gathered.empty() || (point.x > extent.Xmax)) extent.Xmax = point.x;
+			if( gathered.empty() || (point.y < extent.Ymin)) extent.Ymin = point.y;
+			if( gathered.empty() || (point.y > extent.Ymax)) extent.Ymax = point.y;
+			gathered.push_back( point);
+		}
+		if( gathered.empty() || polygons.empty()) {
+			return( 0);
+		}
+
+		// Bucket the points into grid cells in Z curve order, with about four points a cell
+		int gridBits = 1;
+		while( (JOIN_MAX_GRID_BITS > gridBits) && ((gathered.size() / 4) > ((size_t) 1 << (2 * gridBits)))) {
+			++ gridBits;
+		}
+		double gridSize = (double) (1 << gridBits);
+		double width = extent.Xmax - extent.Xmin;
+		double height = extent.Ymax - extent.Ymin;
+		double scaleX = (0.0 < width) ? (gridSize / width) : 0.0;
+		double scaleY = (0.0 < height) ? (gridSize / height) : 0.0;
+		double maxCell = (double) ((1 << gridBits) - 1);
+		std::vector<std::uint32_t> cells( gathered.size());
+		std::vector<size_t> cellStarts( ((size_t) 1 << (2 * gridBits)) + 1, 0);
+		for( size_t nPoint = 0; gathered.size() > nPoint; ++ nPoint) {
+
+			// Clamped before the cast, as an extent too wide for a double gives NaN
+			double gridX = (gathered[nPoint].x - extent.Xmin) * scaleX;
+			double gridY = (gathered[nPoint].y - extent.Ymin) * scaleY;
+			std::uint32_t nX = (0.0 < gridX) ? ((maxCell < gridX) ? (std::uint32_t) maxCell : (std::uint32_t) gridX) : 0;
+			std::uint32_t nY = (0.0 < gridY) ? ((maxCell < gridY) ? (std::uint32_t) maxCell : (std::uint32_t) gridY) : 0;
+			cells[nPoint] = spreadBits( nX) | (spreadBits( nY) << 1);
+			++ cellStarts[cells[nPoint] + 1];
+		}
+		for( size_t nCell = 1; cellStarts.size() > nCell; ++ nCell) {
+			cellStarts[nCell] += cellStarts[nCell - 1];
+		}
+		std::vector<S_JOIN_POINT> ordered( gathered.size());
+		std::vector<size_t> cellFill( cellStarts.begin(), cellStarts.end() - 1);
+		for( size_t nPoint = 0; gathered.size() > nPoint; ++ nPoint) {
+			ordered[cellFill[cells[nPoint]] ++] = gathered[nPoint];
+		}
+
+		// Cut the curve into partitions of whole cells
+		std::vector<size_t> partitionStarts( 1, 0);
+		for( size_t nCell = 1; cellStarts.size() > nCell; ++ nCell) {
+			if( (cellStarts[nCell] - partitionStarts.back()) >= JOIN_PARTITION_POINTS) {
+				partitionStarts.push_back( cellStarts[nCell]);
+			}
+		}
+		if( ordered.size() != partitionStarts.back()) {
+			partitionStarts.push_back( ordered.size());
+		}
+
+		// Index and prepare the polygons, then join
+		ShapeRTree tree( polygons);
+		std::vector<PreparedPolygon *> prepared( polygons.size(), (PreparedPolygon *) 0x0);
+		size_t numVisited = 0;
+		try {
+			PolygonPrepareTask prepareTask( polygons, prepared);
+			runParallel( prepareTask, prepareTask.getBlockCount(), numThreads);
+			PointJoinTask joinTask( ordered, partitionStarts, tree, polygons, prepared, visitor);
+			runParallel( joinTask, joinTask.getBlockCount(), numThreads);
+			numVisited = joinTask.getVisitedCount();
+		}
+		catch( ...) {
+			for( size_t nPolygon = 0; prepared.size() > nPolygon; ++ nPolygon) {
+				delete prepared[nPolygon];
+			}
+			throw;
+		}
+		for( size_t nPolygon = 0; prepared.size() > nPolygon; ++ nPolygon) {
+			delete prepared[nPolygon];
+		}
+		return( numVisited);
+
+	}
+
+	size_t joinPointsToPolygons( const Reader &pointReader, const Reader &polygonReader, JoinVisitor &visitor,
+		const unsigned int numThreads) {
+
+		return( joinPointsToPolygons( pointReader.getShapes(), polygonReader.getShapes(), visitor, numThreads));
+
+	}
+
+};
@@ -0,0 +1,164 @@
+//
+//  libShapeStream.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project includes
+#include <libShapeStream.hpp>
+
+namespace libShape {
+
+	///////////////////
+	// SHAPE VISITOR //
+	///////////////////
+
+	ShapeVisitor::ShapeVisitor() {
+
+	}
+
+	ShapeVisitor::~ShapeVisitor() {
+
+	}
+
+	///////////////////
+	// STREAM READER //
+	///////////////////
+
+	// Construction - read the header
+	StreamReader::StreamReader( InputSource &source, const bool bStrict) : input(source), nCurRec(0), bStrictRecords(bStrict) {
+
+		// Clear the header information
+		memset(&header, 0x0, sizeof(header));
+
+		// Attempt to read the raw header information
+		BYTE headerBuff[100];
+		memset(headerBuff, 0x0, sizeof(headerBuff));
+		if( 100 != input.readFully( headerBuff, 100)) {
+			throw( new ShapeException( std::string("Insufficient bytes to gather shape file header")));
+		}
+		decodeShapeHeader( headerBuff, header);
+
+	}
+
+	// Destruction
+	StreamReader::~StreamReader() {
+
+	}
+
+	// Read the next shape
+	AbstractShape * StreamReader::nextShape() {
+
+		// Read the record number and size
+		BYTE recStart[8];
+		memset(recStart, 0x0, sizeof(recStart));
+		size_t tRead = input.readFully( recStart, 8);
+		if( 0x0 == tRead) {
+			return( (AbstractShape *) 0x0);
+		}
+		else if( 8 != tRead) {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to read record header at current record %lu - expected 8 bytes got %lu bytes", nCurRec, tRead);
+			throw( new ShapeException( std::string( msg)));
+		}
+		// The size is in 16 bit words, and is bounded as the original reader's buffer was
+		int nRecordNumber = getInteger( recStart + 0);
+		int nRecordWords = getInteger( recStart + 4);
+		if( (0 > nRecordWords) || (Reader::MAXIMUM_RECORD_SIZE < (2 * (size_t) nRecordWords))) {
+			char msg[1024 + 1];
+			sprintf( msg, "At current record %lu, invalid record size %d words", nCurRec, nRecordWords);
+			throw( new ShapeException( std::string( msg)));
+		}
+		size_t recordSize = 2 * (size_t) nRecordWords;
+
+		// Grow the buffer only as needed - it is reused for every record
+		if( recordBuffer.size() < recordSize) {
+			recordBuffer.resize( recordSize);
+		}
+
+		// Read in this value
+		BYTE *pBuffer = recordBuffer.empty() ? recStart : &recordBuffer[0];
+		tRead = input.readFully( pBuffer, recordSize);
+		if( tRead != recordSize) {
+			char msg[1024 + 1];
+			sprintf( msg, "At current record %lu, expected to read %lu but only read %lu", nCurRec, recordSize, tRead);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Build the shape - records too short to hold a shape type are invalid
+		AbstractShape *pShape = buildShape( nRecordNumber, pBuffer, tRead);
+		if( (AbstractShape *) 0x0 == pShape) {
+			pShape = new ShapeInvalid( nRecordNumber);
+		}
+		if( bStrictRecords && (SHAPE_INVALID == pShape->getShapeType())) {
+			delete pShape;
+			char msg[1024 + 1];
+			sprintf( msg, "At current record %lu, record %d is not a valid shape", nCurRec, nRecordNumber);
+			throw( new ShapeException( std::string( msg)));
+		}
+		++nCurRec;
+		return( pShape);
+
+	}
+
+	// Visit all remaining shapes
+	unsigned long StreamReader::visitShapes( ShapeVisitor &visitor) {
+
+		unsigned long nVisited = 0;
+		AbstractShape *pShape = (AbstractShape *) 0x0;
+		while( (AbstractShape *) 0x0 != (pShape = nextShape())) {
+
+			// Visit and discard
+			bool bContinue = true;
+			try {
+				bContinue = visitor.visitShape( *pShape);
+			}
+			catch( ...) {
+				delete pShape;
+				throw;
+			}
+			delete pShape;
+			++ nVisited;
+
+			// Stop early?
+			if( !bContinue) break;
+
+		}
+		return( nVisited);
+
+	}
+
+};
@@ -0,0 +1,169 @@
+//
+//  libShapeThreads.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+
+// STL includes
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project includes
+#include <libShapeDB.hpp>
+#include <libShapeFile.hpp>
+#include <libShapeThreads.hpp>
+
+namespace libShape {
+
+	// The shared state of one parallel run
+	struct s_parallel_run {
+		ParallelTask *pTask;
+		size_t numBlocks;
+		std::atomic<size_t> nextBlock;
+		std::atomic<bool> bFailed;
+		std::mutex errorLock;
+		std::exception_ptr firstError;
+	};
+	typedef struct s_parallel_run S_PARALLEL_RUN;
+
+	// Keep the exception being handled if it is the first failure - false if it is dropped
+	static bool keepFirstError( S_PARALLEL_RUN *pRun) {
+
+		std::lock_guard<std::mutex> guard( pRun->errorLock);
+		if( pRun->bFailed.load()) {
+			return( false);
+		}
+		pRun->firstError = std::current_exception();
+		pRun->bFailed.store( true);
+		return( true);
+
+	}
+
+	// The worker loop - claim blocks until none remain
+	static void runWorker( S_PARALLEL_RUN *pRun) {
+
+		while( !pRun->bFailed.load()) {
+
+			// Claim the next block
+			size_t nBlock = pRun->nextBlock.fetch_add( 1);
+			if( pRun->numBlocks <= nBlock) break;
+
+			// And run it, keeping only the first failure - the library's exceptions are
+			// thrown by pointer, so those dropped are deleted here
+			try {
+				pRun->pTask->runBlock( nBlock);
+			}
+			catch( ShapeException *pExcp) {
+				if( !keepFirstError( pRun)) {
+					delete pExcp;
+				}
+			}
+			catch( dbException *pExcp) {
+				if( !keepFirstError( pRun)) {
+					delete pExcp;
+				}
+			}
+			catch( ...) {
+				keepFirstError( pRun);
+			}
+
+		}
+
+	}
+
+	ParallelTask::ParallelTask() {
+
+	}
+
+	ParallelTask::~ParallelTask() {
+
+	}
+
+	unsigned int getThreadCount( const unsigned int numThreads) {
+
+		if( 0 != numThreads) return( numThreads);
+		unsigned int numCores = std::thread::hardware_concurrency();
+		return( (0 == numCores) ? 1 : numCores);
+
+	}
+
+	void runParallel( ParallelTask &task, const size_t numBlocks, const unsigned int numThreads) {
+
+		// Set up the run
+		S_PARALLEL_RUN run;
+		run.pTask = &task;
+		run.numBlocks = numBlocks;
+		run.nextBlock.store( 0);
+		run.bFailed.store( false);
+
+		// No more threads than blocks - and the caller is one of the threads
+		size_t numWorkers = getThreadCount( numThreads);
+		if( numBlocks < numWorkers) numWorkers = numBlocks;
+		// The vector is sized first, so only starting a thread can fail - the threads already
+		// started are then stopped and joined before the failure is passed on.  A run on the
+		// caller's thread alone allocates nothing.
+		std::vector<std::thread> workers;
+		if( 1 < numWorkers) {
+			workers.reserve( numWorkers - 1);
+		}
+		try {
+			for( size_t nWorker = 1; numWorkers > nWorker; ++ nWorker) {
+				workers.emplace_back( runWorker, &run);
+			}
+		}
+		catch( ...) {
+			run.nextBlock.store( numBlocks);
+			run.bFailed.store( true);
+			for( size_t nWorker = 0; workers.size() > nWorker; ++ nWorker) {
+				workers[nWorker].join();
+			}
+			throw;
+		}
+		runWorker( &run);
+		for( size_t nWorker = 0; workers.size() > nWorker; ++ nWorker) {
+			workers[nWorker].join();
+		}
+
+		// Report any failure
+		if( run.bFailed.load()) {
+			std::rethrow_exception( run.firstError);
+		}
+
+	}
+
+};
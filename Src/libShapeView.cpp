@@ -0,0 +1,234 @@
+//
+//  libShapeView.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+
+// Project includes
+#include <libShapeView.hpp>
+
+namespace libShape {
+
+	///////////////////
+	// RECORD CURSOR //
+	///////////////////
+
+	RecordCursor::RecordCursor( const BYTE *pData, const size_t dataSize) :
+		pImage( pData), imageSize( dataSize), nextPos( 100), nCurRec( 0),
+		nRecordNum( 0), eShapeType( SHAPE_NULL), pRecord( (const BYTE *) 0x0), recSize( 0) {
+
+		// Must hold at least the file header
+		if( 100 > dataSize) {
+			throw( new ShapeException( std::string( "Insufficient bytes for header")));
+		}
+
+	}
+
+	RecordCursor::~RecordCursor() {
+
+	}
+
+	bool RecordCursor::next() {
+
+		// Done?
+		if( imageSize <= nextPos) {
+			return( false);
+		}
+
+		// Get the record number and size
+		size_t tAvail = imageSize - nextPos;
+		if( 8 > tAvail) {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to read record header at current record %lu - expected 8 bytes got %lu bytes", nCurRec, tAvail);
+			throw( new ShapeException( std::string( msg)));
+		}
+		int nRecordNumber = getInteger( pImage + nextPos + 0);
+		int nRecordSize = 2 * getInteger( pImage + nextPos + 4);
+		tAvail -= 8;
+
+		// The record must be entirely within the image
+		if( (0 > nRecordSize) || (tAvail < (size_t) nRecordSize)) {
+			char msg[1024 + 1];
+			sprintf( msg, "At current record %lu, expected to read %d but only read %lu", nCurRec, nRecordSize, tAvail);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// And position on the record
+		nRecordNum = nRecordNumber;
+		pRecord = pImage + nextPos + 8;
+		recSize = nRecordSize;
+		eShapeType = (4 > recSize) ? SHAPE_INVALID : convertIntToShape( * ((std::int32_t *) pRecord));
+		nextPos += 8 + recSize;
+		++ nCurRec;
+		return( true);
+
+	}
+
+	////////////////
+	// POINT VIEW //
+	////////////////
+
+	PointView::PointView( const int recordNum, const BYTE *pBuffer, const size_t bufSize) :
+		nRecordNum( recordNum), pContent( pBuffer) {
+
+		// Must be at least 16 bytes
+		if( 16 > bufSize) {
+			throw( new ShapeException( std::string( "Insufficient bytes for point shape")));
+		}
+
+	}
+
+	S_POINT PointView::getPoint() const {
+
+		S_POINT point;
+		memset( &point, 0x0, sizeof( point));
+		point.x = getX();
+		point.y = getY();
+		return( point);
+
+	}
+
+	S_BOUNDING_BOX PointView::getBoundingBox() const {
+
+		double x = getX();
+		double y = getY();
+		S_BOUNDING_BOX box = { x, y, x, y };
+		return( box);
+
+	}
+
+	bool PointView::containsPoint( double x, double y) const {
+
+		return( dblEquals( getX(), x) && dblEquals( getY(), y));
+
+	}
+
+	////////////////
+	// PARTS VIEW //
+	////////////////
+
+	PartsView::PartsView( const int recordNum, const E_SHAPE_TYPE shapeType, const BYTE *pBuffer, const size_t bufSize) :
+		nRecordNum( recordNum), eShapeType( shapeType), pContent( pBuffer), pPoints( (const BYTE *) 0x0), numParts( 0), numPoints( 0) {
+
+		// Must be at least 40 bytes
+		if( 40 > bufSize) {
+			throw( new ShapeException( std::string( (SHAPE_POLYGON == shapeType) ?
+				"Insufficient bytes for polygon shape" : "Insufficient bytes for polyline shape")));
+		}
+
+		// Get the number of parts and points
+		numParts = * ((int *) (pBuffer + 32));
+		numPoints = * ((int *) (pBuffer + 36));
+		if( (0 > numParts) || (0 > numPoints) ||
+			(bufSize < (40 + (4 * (size_t) numParts) + (16 * (size_t) numPoints)))) {
+			throw( new ShapeException( std::string( "Exceeded structure size reading points")));
+		}
+		pPoints = pBuffer + 40 + (4 * numParts);
+
+		// The part offsets are read in place, so check they only ever advance
+		int nLastIndex = 0;
+		for( int nPart = 1; numParts > nPart; ++ nPart) {
+			int nIndexPt = * ((int *) (pBuffer + 40 + (4 * nPart)));
+			if( (nIndexPt < nLastIndex) || (nIndexPt > numPoints)) {
+				throw( new ShapeException( std::string( "Exceeded structure size reading points")));
+			}
+			nLastIndex = nIndexPt;
+		}
+
+	}
+
+	S_BOUNDING_BOX PartsView::getBoundingBox() const {
+
+		S_BOUNDING_BOX box;
+		box.Xmin = * ((double *) (pContent + 0));
+		box.Ymin = * ((double *) (pContent + 8));
+		box.Xmax = * ((double *) (pContent + 16));
+		box.Ymax = * ((double *) (pContent + 24));
+		return( box);
+
+	}
+
+	S_POINT PartsView::getPoint( const int nPoint) const {
+
+		S_POINT point;
+		memset( &point, 0x0, sizeof( point));
+		point.x = getX( nPoint);
+		point.y = getY( nPoint);
+		return( point);
+
+	}
+
+	///////////////////
+	// POLYLINE VIEW //
+	///////////////////
+
+	PolylineView::PolylineView( const int recordNum, const BYTE *pBuffer, const size_t bufSize) :
+		PartsView( recordNum, SHAPE_POLYLINE, pBuffer, bufSize) {
+
+	}
+
+	//////////////////
+	// POLYGON VIEW //
+	//////////////////
+
+	PolygonView::PolygonView( const int recordNum, const BYTE *pBuffer, const size_t bufSize) :
+		PartsView( recordNum, SHAPE_POLYGON, pBuffer, bufSize) {
+
+	}
+
+	bool PolygonView::containsPoint( double x, double y) const {
+
+		// Same rules as ShapePolygon
+		bool atLeastOneContained = false;
+		bool noLeftCircles = true;
+		const double *pXY = getXY();
+		for( int nPart = 0; numParts > nPart; ++ nPart) {
+
+			// Winding number of current point must be negative (right circling)
+			const double *pStart = pXY + (2 * getPartStart( nPart));
+			int checkPtWindingNumber = getWindingNumber( pStart, pStart + 1, getPartSize( nPart), x, y, 2);
+
+			// Need at least one contained inside, and no left circling
+			noLeftCircles &= (0 >= checkPtWindingNumber);
+			atLeastOneContained |= (0 > checkPtWindingNumber);
+
+		} // endfor loop thru parts
+
+		// And done
+		return( noLeftCircles && atLeastOneContained);
+
+	}
+
+};
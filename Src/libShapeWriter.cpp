@@ -0,0 +1,596 @@
+//
+//  libShapeWriter.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// STL includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project includes
+#include <libShapeWriter.hpp>
+
+namespace libShape {
+
+	// The size of the shape and index file headers
+	static const size_t SHAPE_HEADER_SIZE = 100;
+
+	// The largest file the 16-bit word offsets of the index can reach
+	static const std::uint64_t MAX_SHAPE_FILE_SIZE = 2 * (std::uint64_t) 0x7FFFFFFF;
+
+	// Encode a big endian integer
+	static void putBigInteger( BYTE *pBuffer, const std::int32_t value) {
+
+		pBuffer[0] = (BYTE) (value >> 24);
+		pBuffer[1] = (BYTE) (value >> 16);
+		pBuffer[2] = (BYTE) (value >> 8);
+		pBuffer[3] = (BYTE) value;
+
+	}
+
+	// Encode a little endian integer
+	static void putInteger( BYTE *pBuffer, const std::int32_t value) {
+
+		pBuffer[0] = (BYTE) value;
+		pBuffer[1] = (BYTE) (value >> 8);
+		pBuffer[2] = (BYTE) (value >> 16);
+		pBuffer[3] = (BYTE) (value >> 24);
+
+	}
+
+	// Encode a double - native order, as the shapes are decoded
+	static void putDouble( BYTE *pBuffer, const double value) {
+
+		memcpy( pBuffer, &value, sizeof( double));
+
+	}
+
+	// Encode a bounding box
+	static void putBox( BYTE *pBuffer, const S_BOUNDING_BOX &box) {
+
+		putDouble( pBuffer + 0, box.Xmin);
+		putDouble( pBuffer + 8, box.Ymin);
+		putDouble( pBuffer + 16, box.Xmax);
+		putDouble( pBuffer + 24, box.Ymax);
+
+	}
+
+	// Grow a box to hold a point
+	static void addToBox( S_BOUNDING_BOX &box, const bool bFirst, const double x, const double y) {
+
+		if( bFirst) {
+			box.Xmin = box.Xmax = x;
+			box.Ymin = box.Ymax = y;
+			return;
+		}
+		if( x < box.Xmin) box.Xmin = x;
+		if( x > box.Xmax) box.Xmax = x;
+		if( y < box.Ymin) box.Ymin = y;
+		if( y > box.Ymax) box.Ymax = y;
+
+	}
+
+	////////////
+	// WRITER //
+	////////////
+
+	const size_t Writer::DEFAULT_BUFFER_SIZE = 4 << 20;
+
+	// Create the files
+	Writer::Writer( const char *strBaseName, const E_SHAPE_TYPE eShapeType, const CNT_FIELDS &fields, const size_t bufferSize) :
+		eFileType( eShapeType), dbFields( fields), recSize( 1), numRecords( 0), bHasExtent( false), bClosed( false) {
+
+		memset( &extent, 0x0, sizeof( extent));
+		shapeFile.fFile = indexFile.fFile = dbFile.fFile = (FILE *) 0x0;
+
+		// Validate input
+		if( (const char *) 0x0 == strBaseName) {
+			throw( new ShapeException( std::string( "NULL base file name not permitted")));
+		}
+		strBase = strBaseName;
+		if( (SHAPE_POINT != eShapeType) && (SHAPE_POLYLINE != eShapeType) && (SHAPE_POLYGON != eShapeType)) {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to write shape files of type %d", (int) eShapeType);
+			throw( new ShapeException( std::string( msg)));
+		}
+		if( fields.empty()) {
+			throw( new ShapeException( std::string( "DB files need at least one field")));
+		}
+
+		// Lay out the records
+		for( size_t nField = 0; fields.size() > nField; ++ nField) {
+			if( dbField::FT_INVALID == fields[nField].getType()) {
+				char msg[1024 + 1];
+				snprintf( msg, sizeof( msg), "Unable to write field %s of invalid type", fields[nField].getName());
+				throw( new ShapeException( std::string( msg)));
+			}
+			fieldOffsets.push_back( recSize);
+			recSize += fields[nField].getLength();
+		}
+		if( 0xFFFF < recSize) {
+			char msg[1024 + 1];
+			sprintf( msg, "DB record size %lu is too large", recSize);
+			throw( new ShapeException( std::string( msg)));
+		}
+		nextRecord.assign( recSize, ' ');
+
+		// Create the files, leaving room for the headers
+		try {
+			openFile( shapeFile, ".shp", bufferSize);
+			openFile( indexFile, ".shx", bufferSize);
+			openFile( dbFile, ".dbf", bufferSize);
+		}
+		catch( ShapeException *pExcp) {
+			closeFiles();
+			throw( pExcp);
+		}
+		memset( reserve( shapeFile, SHAPE_HEADER_SIZE), 0x0, SHAPE_HEADER_SIZE);
+		memset( reserve( indexFile, SHAPE_HEADER_SIZE), 0x0, SHAPE_HEADER_SIZE);
+		size_t dbHeaderSize = 32 + (32 * fields.size()) + 1;
+		memset( reserve( dbFile, dbHeaderSize), 0x0, dbHeaderSize);
+
+	}
+
+	// Destruction
+	Writer::~Writer() {
+
+		try {
+			close();
+		}
+		catch( ShapeException *pExcp) {
+			delete pExcp;
+		}
+
+	}
+
+	// Open one of the files
+	void Writer::openFile( S_OUTPUT_FILE &file, const char *strExtension, const size_t bufferSize) {
+
+		std::string strFileName = strBase + strExtension;
+		file.fFile = fopen( strFileName.c_str(), "wb");
+		if( (FILE *) 0x0 == file.fFile) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to create %s", strFileName.c_str());
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Whole buffers are written at once, so stdio need not buffer again
+		setvbuf( file.fFile, (char *) 0x0, _IONBF, 0);
+		file.buffer.resize( (0 < bufferSize) ? bufferSize : 1);
+		file.bufferUsed = 0;
+		file.fileSize = 0;
+
+	}
+
+	// Close the open files
+	bool Writer::closeFiles() {
+
+		bool bClosedAll = true;
+		S_OUTPUT_FILE *pFiles[] = { &shapeFile, &indexFile, &dbFile };
+		for( size_t nFile = 0; 3 > nFile; ++ nFile) {
+			if( (FILE *) 0x0 != pFiles[nFile]->fFile) {
+				bClosedAll = (0 == fclose( pFiles[nFile]->fFile)) && bClosedAll;
+				pFiles[nFile]->fFile = (FILE *) 0x0;
+			}
+		}
+		return( bClosedAll);
+
+	}
+
+	// Make room in a buffer
+	BYTE * Writer::reserve( S_OUTPUT_FILE &file, const size_t numBytes) {
+
+		if( (file.buffer.size() - file.bufferUsed) < numBytes) {
+			if( !flush( file)) {
+				throw( new ShapeException( std::string( "Unable to write to ") + strBase));
+			}
+			if( file.buffer.size() < numBytes) {
+				file.buffer.resize( numBytes);
+			}
+		}
+		BYTE *pBytes = &file.buffer[file.bufferUsed];
+		file.bufferUsed += numBytes;
+		file.fileSize += numBytes;
+		return( pBytes);
+
+	}
+
+	// Write out a buffer
+	bool Writer::flush( S_OUTPUT_FILE &file) {
+
+		bool bWritten = (0 == file.bufferUsed) || (1 == fwrite( &file.buffer[0], file.bufferUsed, 1, file.fFile));
+		file.bufferUsed = 0;
+		return( bWritten);
+
+	}
+
+	// Fail once closed
+	void Writer::checkOpen() const {
+
+		if( bClosed) {
+			throw( new ShapeException( std::string( "Unable to add to closed files ") + strBase));
+		}
+
+	}
+
+	// Get the bytes of a field
+	char * Writer::getFieldBytes( const size_t nField) {
+
+		if( dbFields.size() <= nField) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid field %lu of %lu", nField, dbFields.size());
+			throw( new ShapeException( std::string( msg)));
+		}
+		return( (char *) &nextRecord[fieldOffsets[nField]]);
+
+	}
+
+	// Set a text value
+	void Writer::setString( const size_t nField, const char *pText, const size_t length) {
+
+		char *pField = getFieldBytes( nField);
+		size_t fieldLength = dbFields[nField].getLength();
+		size_t numCopied = (length < fieldLength) ? length : fieldLength;
+		if( 0 < numCopied) {
+			memcpy( pField, pText, numCopied);
+		}
+		memset( pField + numCopied, ' ', fieldLength - numCopied);
+
+	}
+
+	// Set a numeric value
+	void Writer::setDouble( const size_t nField, const double value) {
+
+		char *pField = getFieldBytes( nField);
+		const dbField &field = dbFields[nField];
+		if( isnan( value)) {
+			memset( pField, ' ', field.getLength());
+			return;
+		}
+		char text[512 + 1];
+		int numChars = snprintf( text, sizeof( text), "%*.*f", (int) field.getLength(), (int) field.getDecimalCount(), value);
+		if( isinf( value) || (0 > numChars) || (field.getLength() < (size_t) numChars)) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Value %g does not fit field %s", value, field.getName());
+			throw( new ShapeException( std::string( msg)));
+		}
+		memcpy( pField, text, field.getLength());
+
+	}
+
+	// Set an integer value
+	void Writer::setInt64( const size_t nField, const std::int64_t value) {
+
+		char *pField = getFieldBytes( nField);
+		const dbField &field = dbFields[nField];
+		char text[512 + 1];
+		int numChars = 0;
+		if( 0 == field.getDecimalCount()) {
+			numChars = snprintf( text, sizeof( text), "%*lld", (int) field.getLength(), (long long) value);
+		}
+		else {
+			int intLength = (int) (field.getLength() - field.getDecimalCount() - 1);
+			numChars = snprintf( text, sizeof( text), "%*lld.%0*d", intLength, (long long) value, (int) field.getDecimalCount(), 0);
+		}
+		if( (0 > numChars) || (field.getLength() < (size_t) numChars)) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Value %lld does not fit field %s", (long long) value, field.getName());
+			throw( new ShapeException( std::string( msg)));
+		}
+		memcpy( pField, text, field.getLength());
+
+	}
+
+	// Set a logical value
+	void Writer::setBool( const size_t nField, const bool value) {
+
+		char *pField = getFieldBytes( nField);
+		memset( pField, ' ', dbFields[nField].getLength());
+		pField[0] = value ? 'T' : 'F';
+
+	}
+
+	// Set a whole record
+	void Writer::setRecordBytes( const BYTE *pRecord, const size_t recordSize) {
+
+		if( ((const BYTE *) 0x0 == pRecord) || (recSize != recordSize)) {
+			char msg[1024 + 1];
+			sprintf( msg, "Expected a record of %lu bytes, but got %lu", recSize, recordSize);
+			throw( new ShapeException( std::string( msg)));
+		}
+		memcpy( &nextRecord[0], pRecord, recSize);
+
+	}
+
+	// Start a shape record
+	BYTE * Writer::beginShape( const size_t contentSize) {
+
+		// The offsets and lengths of the index are in 16-bit words
+		std::uint64_t offset = shapeFile.fileSize;
+		if( (MAX_SHAPE_FILE_SIZE - offset) < (8 + (std::uint64_t) contentSize)) {
+			throw( new ShapeException( std::string( "Shape file would exceed the largest size possible: ") + strBase));
+		}
+		BYTE *pRecord = reserve( shapeFile, 8 + contentSize);
+		putBigInteger( pRecord, (std::int32_t) (numRecords + 1));
+		putBigInteger( pRecord + 4, (std::int32_t) (contentSize / 2));
+		BYTE *pIndex = reserve( indexFile, 8);
+		putBigInteger( pIndex, (std::int32_t) (offset / 2));
+		putBigInteger( pIndex + 4, (std::int32_t) (contentSize / 2));
+		return( pRecord + 8);
+
+	}
+
+	// Write a polyline or polygon
+	void Writer::writeParts( const E_SHAPE_TYPE eShapeType, const size_t numParts, const size_t numPoints,
+		const CNT_POINTS *pParts, const FlatShape *pFlat) {
+
+		if( (0x7FFFFFFF < numParts) || (0x7FFFFFFF < numPoints)) {
+			throw( new ShapeException( std::string( "Too many parts or points to write a shape to ") + strBase));
+		}
+		BYTE *pContent = beginShape( 44 + (4 * numParts) + (16 * numPoints));
+		putInteger( pContent, eShapeType);
+		putInteger( pContent + 36, (std::int32_t) numParts);
+		putInteger( pContent + 40, (std::int32_t) numPoints);
+
+		// The parts, then the points, finding the box as they go
+		BYTE *pPartStarts = pContent + 44;
+		BYTE *pPoint = pPartStarts + (4 * numParts);
+		S_BOUNDING_BOX box;
+		memset( &box, 0x0, sizeof( box));
+		size_t nPoint = 0;
+		for( size_t nPart = 0; numParts > nPart; ++ nPart) {
+			putInteger( pPartStarts + (4 * nPart), (std::int32_t) nPoint);
+			if( (const CNT_POINTS *) 0x0 != pParts) {
+				const CNT_POINTS &part = pParts[nPart];
+				for( size_t nCur = 0; part.size() > nCur; ++ nCur, ++ nPoint, pPoint += 16) {
+					putDouble( pPoint, part[nCur].x);
+					putDouble( pPoint + 8, part[nCur].y);
+					addToBox( box, 0 == nPoint, part[nCur].x, part[nCur].y);
+				}
+			}
+			else {
+				const double *pX = pFlat->getPartX( nPart);
+				const double *pY = pFlat->getPartY( nPart);
+				size_t partSize = pFlat->getPartSize( nPart);
+				for( size_t nCur = 0; partSize > nCur; ++ nCur, ++ nPoint, pPoint += 16) {
+					putDouble( pPoint, pX[nCur]);
+					putDouble( pPoint + 8, pY[nCur]);
+					addToBox( box, 0 == nPoint, pX[nCur], pY[nCur]);
+				}
+			}
+		}
+		putBox( pContent + 4, box);
+		endRecord( 0 < numPoints, box);
+
+	}
+
+	// Finish a record
+	void Writer::endRecord( const bool bShapeExtent, const S_BOUNDING_BOX &box) {
+
+		memcpy( reserve( dbFile, recSize), &nextRecord[0], recSize);
+		memset( &nextRecord[0], ' ', recSize);
+		++ numRecords;
+		if( bShapeExtent) {
+			addToBox( extent, !bHasExtent, box.Xmin, box.Ymin);
+			addToBox( extent, false, box.Xmax, box.Ymax);
+			bHasExtent = true;
+		}
+
+	}
+
+	// Append a record
+	void Writer::addRecord( const AbstractShape *pShape) {
+
+		checkOpen();
+
+		// Null shapes
+		if( ((const AbstractShape *) 0x0 == pShape) || (SHAPE_NULL == pShape->getShapeType())) {
+			S_BOUNDING_BOX box;
+			memset( &box, 0x0, sizeof( box));
+			putInteger( beginShape( 4), SHAPE_NULL);
+			endRecord( false, box);
+			return;
+		}
+
+		// Every other shape must be of the file's type
+		if( eFileType != pShape->getShapeType()) {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to write a shape of type %d to a file of type %d", (int) pShape->getShapeType(), (int) eFileType);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Points
+		const FlatShape *pFlat = dynamic_cast<const FlatShape *>( pShape);
+		const ShapePoint *pPoint = dynamic_cast<const ShapePoint *>( pShape);
+		if( SHAPE_POINT == eFileType) {
+			double x = 0.0;
+			double y = 0.0;
+			if( (const ShapePoint *) 0x0 != pPoint) {
+				x = pPoint->getPoint().x;
+				y = pPoint->getPoint().y;
+			}
+			else if( ((const FlatShape *) 0x0 != pFlat) && (0 < pFlat->getPartCount()) && (0 < pFlat->getPartSize( 0))) {
+				x = pFlat->getPartX( 0)[0];
+				y = pFlat->getPartY( 0)[0];
+			}
+			else if( (const FlatShape *) 0x0 != pFlat) {
+				addRecord( (const AbstractShape *) 0x0);
+				return;
+			}
+			else {
+				char msg[1024 + 1];
+				sprintf( msg, "Unable to write the point of record %d", pShape->getRecordNumber());
+				throw( new ShapeException( std::string( msg)));
+			}
+			BYTE *pContent = beginShape( 20);
+			putInteger( pContent, SHAPE_POINT);
+			putDouble( pContent + 4, x);
+			putDouble( pContent + 12, y);
+			S_BOUNDING_BOX box = { x, y, x, y };
+			endRecord( true, box);
+			return;
+		}
+
+		// Flat polylines and polygons
+		if( (const FlatShape *) 0x0 != pFlat) {
+			size_t numParts = pFlat->getPartCount();
+			size_t numPoints = 0;
+			for( size_t nPart = 0; numParts > nPart; ++ nPart) {
+				numPoints += pFlat->getPartSize( nPart);
+			}
+			writeParts( eFileType, numParts, numPoints, (const CNT_POINTS *) 0x0, pFlat);
+			return;
+		}
+
+		// Decoded polylines and polygons
+		const CNT_POINTS *pParts = (const CNT_POINTS *) 0x0;
+		size_t numParts = 0;
+		const ShapePolyline *pLine = dynamic_cast<const ShapePolyline *>( pShape);
+		const ShapePolygon *pPolygon = dynamic_cast<const ShapePolygon *>( pShape);
+		if( (const ShapePolyline *) 0x0 != pLine) {
+			numParts = pLine->getLines().size();
+			pParts = numParts ? &pLine->getLines()[0] : pParts;
+		}
+		else if( (const ShapePolygon *) 0x0 != pPolygon) {
+			numParts = pPolygon->getPolygons().size();
+			pParts = numParts ? &pPolygon->getPolygons()[0] : pParts;
+		}
+		else {
+			char msg[1024 + 1];
+			sprintf( msg, "Unable to write the parts of record %d", pShape->getRecordNumber());
+			throw( new ShapeException( std::string( msg)));
+		}
+		size_t numPoints = 0;
+		for( size_t nPart = 0; numParts > nPart; ++ nPart) {
+			numPoints += pParts[nPart].size();
+		}
+		writeParts( eFileType, numParts, numPoints, pParts, (const FlatShape *) 0x0);
+
+	}
+
+	// Append a record of a flat layer
+	void Writer::addRecord( const FlatLayer &layer, const size_t nShape) {
+
+		if( layer.getShapeCount() <= nShape) {
+			char msg[1024 + 1];
+			sprintf( msg, "Invalid shape %lu of %lu", nShape, layer.getShapeCount());
+			throw( new ShapeException( std::string( msg)));
+		}
+		FlatShape shape = layer.getShape( nShape);
+		if( (SHAPE_NULL != shape.getShapeType()) && (SHAPE_INVALID != shape.getShapeType())) {
+			addRecord( &shape);
+		}
+		else {
+			addRecord( (const AbstractShape *) 0x0);
+		}
+
+	}
+
+	// Write the headers
+	bool Writer::writeHeaders() {
+
+		// The shape and index headers differ only in their lengths
+		BYTE header[SHAPE_HEADER_SIZE];
+		memset( header, 0x0, sizeof( header));
+		putBigInteger( header, 9994);
+		putInteger( header + 28, 1000);
+		putInteger( header + 32, eFileType);
+		putBox( header + 36, extent);
+		putBigInteger( header + 24, (std::int32_t) (shapeFile.fileSize / 2));
+		bool bWritten = (0 == fseek( shapeFile.fFile, 0, SEEK_SET)) && (1 == fwrite( header, sizeof( header), 1, shapeFile.fFile));
+		putBigInteger( header + 24, (std::int32_t) (indexFile.fileSize / 2));
+		bWritten = bWritten && (0 == fseek( indexFile.fFile, 0, SEEK_SET)) && (1 == fwrite( header, sizeof( header), 1, indexFile.fFile));
+
+		// The DB header, fields and terminator
+		std::vector<BYTE> dbHeader( 32 + (32 * dbFields.size()) + 1, 0x0);
+		time_t now = time( (time_t *) 0x0);
+		struct tm today;
+		localtime_r( &now, &today);
+		dbHeader[0] = 0x03;
+		dbHeader[1] = (BYTE) (today.tm_year % 256);
+		dbHeader[2] = (BYTE) (today.tm_mon + 1);
+		dbHeader[3] = (BYTE) today.tm_mday;
+		putInteger( &dbHeader[4], (std::int32_t) numRecords);
+		dbHeader[8] = (BYTE) dbHeader.size();
+		dbHeader[9] = (BYTE) (dbHeader.size() >> 8);
+		dbHeader[10] = (BYTE) recSize;
+		dbHeader[11] = (BYTE) (recSize >> 8);
+		for( size_t nField = 0; dbFields.size() > nField; ++ nField) {
+			const dbField &field = dbFields[nField];
+			BYTE *pDescriptor = &dbHeader[32 + (32 * nField)];
+			strncpy( (char *) pDescriptor, field.getName(), 10);
+			pDescriptor[11] = (dbField::FT_TEXT == field.getType()) ? 'C' : (BYTE) field.getType();
+			pDescriptor[16] = (BYTE) field.getLength();
+			pDescriptor[17] = (BYTE) field.getDecimalCount();
+		}
+		dbHeader.back() = 0x0D;
+		bWritten = bWritten && (0 == fseek( dbFile.fFile, 0, SEEK_SET)) && (1 == fwrite( &dbHeader[0], dbHeader.size(), 1, dbFile.fFile));
+		return( bWritten);
+
+	}
+
+	// Close the files
+	void Writer::close() {
+
+		if( bClosed) {
+			return;
+		}
+		bClosed = true;
+
+		// The DB file ends with a marker, then everything is written out and the headers filled in
+		bool bWritten = true;
+		try {
+			*reserve( dbFile, 1) = 0x1A;
+		}
+		catch( ShapeException *pExcp) {
+			delete pExcp;
+			bWritten = false;
+		}
+		bWritten = flush( shapeFile) && bWritten;
+		bWritten = flush( indexFile) && bWritten;
+		bWritten = flush( dbFile) && bWritten;
+		bWritten = bWritten && writeHeaders();
+		bWritten = closeFiles() && bWritten;
+		if( !bWritten) {
+			throw( new ShapeException( std::string( "Unable to finish writing ") + strBase));
+		}
+
+	}
+
+};
@@ -0,0 +1,436 @@
+//
+//  libShapeZip.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Only with zlib
+#if defined( LIBSHAPE_ZLIB)
+
+// Standard includes
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// STL includes
+#include <string>
+
+// Project includes
+#include <libShapeZip.hpp>
+#include <libShapeFile.hpp>
+
+namespace libShape {
+
+	// The size of each read of compressed bytes
+	static const size_t INFLATE_CHUNK = 1 << 16;
+
+	// Little-endian values of the zip format
+	static unsigned int getLE16( const BYTE *pBuffer) {
+		return( pBuffer[0] | (pBuffer[1] << 8));
+	}
+	static unsigned long getLE32( const BYTE *pBuffer) {
+		return( ((unsigned long) pBuffer[0]) | (((unsigned long) pBuffer[1]) << 8) |
+			(((unsigned long) pBuffer[2]) << 16) | (((unsigned long) pBuffer[3]) << 24));
+	}
+
+	////////////////////
+	// INFLATE SOURCE //
+	////////////////////
+
+	InflateSource::InflateSource( InputSource &source, const bool bGzip) :
+		input(source), bGzipStream(bGzip), inBuffer(INFLATE_CHUNK), bEnded(false) {
+
+		// Gzip or zlib headers are detected, zip members have none
+		memset( &stream, 0x0, sizeof( stream));
+		if( Z_OK != inflateInit2( &stream, bGzip ? (15 + 32) : -15)) {
+			throw( new ShapeException( std::string("Unable to start inflating")));
+		}
+
+	}
+
+	InflateSource::~InflateSource() {
+
+		inflateEnd( &stream);
+
+	}
+
+	size_t InflateSource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		// Inflate until there is some output
+		uInt nWant = (UINT_MAX < bufSize) ? UINT_MAX : (uInt) bufSize;
+		stream.next_out = pBuffer;
+		stream.avail_out = nWant;
+		while( (nWant == stream.avail_out) && !bEnded && (0 != nWant)) {
+
+			// More input?
+			if( 0 == stream.avail_in) {
+				size_t tRead = input.read( &inBuffer[0], inBuffer.size());
+				if( 0 == tRead) {
+					throw( new ShapeException( std::string("Compressed data ends early")));
+				}
+				stream.next_in = &inBuffer[0];
+				stream.avail_in = (uInt) tRead;
+			}
+
+			// Inflate
+			int nResult = inflate( &stream, Z_NO_FLUSH);
+			if( Z_STREAM_END == nResult) {
+
+				// Gzip streams may continue with another member
+				if( bGzipStream && (0 == stream.avail_in)) {
+					size_t tRead = input.read( &inBuffer[0], inBuffer.size());
+					stream.next_in = &inBuffer[0];
+					stream.avail_in = (uInt) tRead;
+				}
+				if( bGzipStream && (0 != stream.avail_in)) {
+					inflateReset( &stream);
+				}
+				else {
+					bEnded = true;
+				}
+
+			}
+			else if( (Z_OK != nResult) && (Z_BUF_ERROR != nResult)) {
+				char msg[1024 + 1];
+				snprintf( msg, sizeof( msg), "Corrupt compressed data: %s", ((const char *) 0x0 == stream.msg) ? "unknown error" : stream.msg);
+				throw( new ShapeException( std::string( msg)));
+			}
+
+		}
+		return( nWant - stream.avail_out);
+
+	}
+
+	/////////////////
+	// GZIP SOURCE //
+	/////////////////
+
+	GzipSource::GzipSource( InputSource &source) : InflateSource( source, true) {
+
+	}
+
+	GzipSource::~GzipSource() {
+
+	}
+
+	/////////////////
+	// ZIP ARCHIVE //
+	/////////////////
+
+	ZipArchive::ZipArchive( const char *strArchive) : fileArchive( (FILE *) 0x0), bOwnFile(true) {
+
+		// Validate input
+		if( (const char *) 0x0 == strArchive) {
+			throw( new ShapeException( std::string("NULL archive name")));
+		}
+		fileArchive = fopen( strArchive, "rb");
+		if( (FILE *) 0x0 == fileArchive) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Unable to open archive %s", strArchive);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// Read the directory
+		try {
+			readDirectory();
+		}
+		catch( ...) {
+			fclose( fileArchive);
+			throw;
+		}
+
+	}
+
+	ZipArchive::ZipArchive( FILE *fArchive) : fileArchive(fArchive), bOwnFile(false) {
+
+		// Validate input
+		if( (FILE *) 0x0 == fArchive) {
+			throw( new ShapeException( std::string("NULL archive file")));
+		}
+		readDirectory();
+
+	}
+
+	ZipArchive::~ZipArchive() {
+
+		if( bOwnFile) {
+			fclose( fileArchive);
+		}
+
+	}
+
+	// Read at an offset - without moving the file, so several members can be read at once
+	size_t ZipArchive::readAt( BYTE *pBuffer, const size_t bufSize, const size_t offset) const {
+
+		size_t tTotal = 0;
+		while( bufSize > tTotal) {
+			ssize_t tRead = pread( fileno( fileArchive), pBuffer + tTotal, bufSize - tTotal, (off_t) (offset + tTotal));
+			if( 0 > tRead) {
+				throw( new ShapeException( std::string("Error reading from archive")));
+			}
+			if( 0 == tRead) break;
+			tTotal += tRead;
+		}
+		return( tTotal);
+
+	}
+
+	// Read the central directory
+	void ZipArchive::readDirectory() {
+
+		// The end of central directory record is within the last 64K and 22 bytes
+		struct stat fileStat;
+		if( 0 != fstat( fileno( fileArchive), &fileStat)) {
+			throw( new ShapeException( std::string("Unable to size archive")));
+		}
+		size_t fileSize = (size_t) fileStat.st_size;
+		size_t tailSize = (fileSize < (65535 + 22)) ? fileSize : (65535 + 22);
+		std::vector<BYTE> tail( tailSize + 1);
+		if( tailSize != readAt( &tail[0], tailSize, fileSize - tailSize)) {
+			throw( new ShapeException( std::string("Unable to read archive directory")));
+		}
+		long nEnd = (long) tailSize - 22;
+		for( ; 0 <= nEnd; -- nEnd) {
+			if( 0x06054B50 == getLE32( &tail[nEnd])) break;
+		}
+		if( 0 > nEnd) {
+			throw( new ShapeException( std::string("Not a zip archive")));
+		}
+		const BYTE *pEnd = &tail[nEnd];
+		size_t numEntries = getLE16( pEnd + 10);
+		size_t dirSize = getLE32( pEnd + 12);
+		size_t dirOffset = getLE32( pEnd + 16);
+		if( (0xFFFF == numEntries) || (0xFFFFFFFF == dirOffset)) {
+			throw( new ShapeException( std::string("Zip64 archives are not supported")));
+		}
+
+		// Read the directory
+		std::vector<BYTE> directory( dirSize + 1);
+		if( dirSize != readAt( &directory[0], dirSize, dirOffset)) {
+			throw( new ShapeException( std::string("Unable to read archive directory")));
+		}
+		size_t curPos = 0;
+		for( size_t nEntry = 0; numEntries > nEntry; ++ nEntry) {
+			if( ((curPos + 46) > dirSize) || (0x02014B50 != getLE32( &directory[curPos]))) {
+				char msg[1024 + 1];
+				sprintf( msg, "Corrupt archive directory at entry %lu", nEntry);
+				throw( new ShapeException( std::string( msg)));
+			}
+			const BYTE *pEntry = &directory[curPos];
+			size_t nameLength = getLE16( pEntry + 28);
+			size_t entrySize = 46 + nameLength + getLE16( pEntry + 30) + getLE16( pEntry + 32);
+			if( (curPos + entrySize) > dirSize) {
+				char msg[1024 + 1];
+				sprintf( msg, "Corrupt archive directory at entry %lu", nEntry);
+				throw( new ShapeException( std::string( msg)));
+			}
+			S_ZIP_MEMBER member;
+			member.name.assign( (const char *) (pEntry + 46), nameLength);
+			member.method = getLE16( pEntry + 10);
+			member.bEncrypted = (0 != (getLE16( pEntry + 8) & 0x1));
+			member.crc = getLE32( pEntry + 16);
+			member.compressedSize = getLE32( pEntry + 20);
+			member.size = getLE32( pEntry + 24);
+			member.localOffset = getLE32( pEntry + 42);
+			if( (0xFFFFFFFF == member.compressedSize) || (0xFFFFFFFF == member.size) || (0xFFFFFFFF == member.localOffset)) {
+				throw( new ShapeException( std::string("Zip64 archives are not supported")));
+			}
+			members.push_back( member);
+			curPos += entrySize;
+		}
+
+	}
+
+	// Find a member by name
+	long ZipArchive::findMember( const char *strName) const {
+
+		if( (const char *) 0x0 == strName) {
+			return( -1);
+		}
+		for( size_t nMember = 0; members.size() > nMember; ++ nMember) {
+			if( members[nMember].name == strName) {
+				return( (long) nMember);
+			}
+		}
+		return( -1);
+
+	}
+
+	// Find a member by the end of its name
+	long ZipArchive::findMemberBySuffix( const char *strSuffix) const {
+
+		if( (const char *) 0x0 == strSuffix) {
+			return( -1);
+		}
+		size_t suffixLength = strlen( strSuffix);
+		for( size_t nMember = 0; members.size() > nMember; ++ nMember) {
+			const std::string &strName = members[nMember].name;
+			if( (strName.size() >= suffixLength) && (0 == strcasecmp( strName.c_str() + (strName.size() - suffixLength), strSuffix))) {
+				return( (long) nMember);
+			}
+		}
+		return( -1);
+
+	}
+
+	///////////////////////
+	// ZIP MEMBER SOURCE //
+	///////////////////////
+
+	// The stored bytes of a member
+	class ZipRangeSource : public InputSource {
+
+	public:
+
+		// Construction
+		ZipRangeSource( const ZipArchive &archive, const size_t offset, const size_t length) :
+			zipArchive(archive), curPos(offset), endPos(offset + length) {
+		}
+
+		// Destruction
+		virtual ~ZipRangeSource() {
+		}
+
+		// Overrides
+		virtual size_t read( BYTE *pBuffer, const size_t bufSize) {
+			size_t tWant = endPos - curPos;
+			if( bufSize < tWant) tWant = bufSize;
+			if( 0 == tWant) {
+				return( 0);
+			}
+			size_t tRead = zipArchive.readAt( pBuffer, tWant, curPos);
+			if( 0 == tRead) {
+				throw( new ShapeException( std::string("Archive member ends early")));
+			}
+			curPos += tRead;
+			return( tRead);
+		}
+
+	protected:
+
+		// The archive
+		const ZipArchive &zipArchive;
+
+		// The current and end positions in the archive
+		size_t curPos;
+		size_t endPos;
+
+	};
+
+	ZipMemberSource::ZipMemberSource( const ZipArchive &archive, const size_t nMember) :
+		pStored( (InputSource *) 0x0), pInflate( (InflateSource *) 0x0), crc( crc32( 0L, Z_NULL, 0)), numRead(0) {
+
+		// Validate input
+		if( archive.getMembers().size() <= nMember) {
+			char msg[1024 + 1];
+			sprintf( msg, "Member %lu out of range, archive has %lu members", nMember, archive.getMembers().size());
+			throw( new ShapeException( std::string( msg)));
+		}
+		member = archive.getMembers()[nMember];
+		if( member.bEncrypted || ((0 != member.method) && (8 != member.method))) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Member %s is encrypted or uses unsupported method %d", member.name.c_str(), member.method);
+			throw( new ShapeException( std::string( msg)));
+		}
+
+		// The data follows the local header, whose name and extra field may differ from the directory's
+		BYTE localHeader[30];
+		if( (30 != archive.readAt( localHeader, 30, member.localOffset)) || (0x04034B50 != getLE32( localHeader))) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Corrupt local header for member %s", member.name.c_str());
+			throw( new ShapeException( std::string( msg)));
+		}
+		size_t dataOffset = member.localOffset + 30 + getLE16( localHeader + 26) + getLE16( localHeader + 28);
+
+		// Read it
+		pStored = new ZipRangeSource( archive, dataOffset, member.compressedSize);
+		if( 8 == member.method) {
+			try {
+				pInflate = new InflateSource( *pStored, false);
+			}
+			catch( ...) {
+				delete pStored;
+				throw;
+			}
+		}
+
+	}
+
+	ZipMemberSource::~ZipMemberSource() {
+
+		delete pInflate;
+		delete pStored;
+
+	}
+
+	size_t ZipMemberSource::read( BYTE *pBuffer, const size_t bufSize) {
+
+		// Read, and keep the check value
+		size_t tRead = readStored( pBuffer, bufSize);
+		if( (member.size - numRead) < tRead) {
+			char msg[1024 + 1];
+			snprintf( msg, sizeof( msg), "Member %s is corrupt - it runs past its size", member.name.c_str());
+			throw( new ShapeException( std::string( msg)));
+		}
+		for( size_t tDone = 0; tRead > tDone; ) {
+			uInt tChunk = ((tRead - tDone) < (size_t) UINT_MAX) ? (uInt) (tRead - tDone) : UINT_MAX;
+			crc = crc32( crc, pBuffer + tDone, tChunk);
+			tDone += tChunk;
+		}
+		numRead += tRead;
+
+		// Check the whole member as soon as its last byte is read - nothing may follow it - or
+		// when the input ends before that
+		if( ((0 < tRead) && (member.size == numRead)) || ((0 == tRead) && (0 != bufSize))) {
+			BYTE nextByte;
+			bool bMore = (0 < tRead) && (0 != readStored( &nextByte, 1));
+			if( bMore || (numRead != member.size) || (crc != member.crc)) {
+				char msg[1024 + 1];
+				snprintf( msg, sizeof( msg), "Member %s is corrupt - check value or size does not match", member.name.c_str());
+				throw( new ShapeException( std::string( msg)));
+			}
+		}
+		return( tRead);
+
+	}
+
+	size_t ZipMemberSource::readStored( BYTE *pBuffer, const size_t bufSize) {
+
+		return( ((InflateSource *) 0x0 != pInflate) ? pInflate -> read( pBuffer, bufSize) : pStored -> read( pBuffer, bufSize));
+
+	}
+
+};
+
+#endif
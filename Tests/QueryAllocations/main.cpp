@@ -0,0 +1,422 @@
+//
+//  main.cpp
+//  libShape
+//
+//  Created by the libShape contributors on 10/16/26.
+//  Copyright © 2026 the libShape contributors.
+//
+
+/***
+
+	MIT License
+
+	Copyright (c) 2026 the libShape contributors
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+***/
+
+// Standard includes
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// STL includes
+#include <new>
+#include <string>
+#include <vector>
+
+// Project includes
+#include <libShape.hpp>
+
+//
+// Global variables
+//
+// g_bCountAllocs, g_numAllocs
+//		Global operator new counts allocations while g_bCountAllocs is set
+//
+// g_numFailures
+//		The number of checks failed
+//
+
+static volatile bool g_bCountAllocs = false;
+static volatile unsigned long g_numAllocs = 0;
+static unsigned long g_numFailures = 0;
+
+//
+// Count allocations
+//
+// Geometry queries must never allocate - every query below is run on
+// structures already built, and the test fails if any allocation is seen
+//
+
+void * operator new( size_t numBytes) {
+	if( g_bCountAllocs) ++ g_numAllocs;
+	void *pMemory = malloc( (0 == numBytes) ? 1 : numBytes);
+	if( (void *) 0x0 == pMemory) throw std::bad_alloc();
+	return( pMemory);
+}
+void * operator new[]( size_t numBytes) {
+	return( operator new( numBytes));
+}
+void operator delete( void *pMemory) noexcept {
+	free( pMemory);
+}
+void operator delete[]( void *pMemory) noexcept {
+	free( pMemory);
+}
+void operator delete( void *pMemory, size_t) noexcept {
+	free( pMemory);
+}
+void operator delete[]( void *pMemory, size_t) noexcept {
+	free( pMemory);
+}
+
+//////////
+// DATA //
+//////////
+
+// The layout - a grid of square polygons, each with a square hole
+static const int GRID_SIZE = 24;
+static const double CELL_SIZE = 10.0;
+
+//
+// Make a square ring
+//
+// Outer rings run clockwise and holes counter-clockwise
+//
+
+static libShape::POLYGON makeRing( const double x, const double y, const double size, const bool bHole) {
+
+	double corners[5][2] = { { x, y }, { x, y + size }, { x + size, y + size }, { x + size, y }, { x, y } };
+	libShape::POLYGON ring;
+	for( int nCorner = 0; 5 > nCorner; ++ nCorner) {
+		int nIndex = bHole ? (4 - nCorner) : nCorner;
+		libShape::S_POINT point = { corners[nIndex][0], corners[nIndex][1], 0.0, 0.0 };
+		ring.push_back( point);
+	}
+	return( ring);
+
+}
+
+//
+// Append the bytes of a polygon record, following the shape type
+//
+
+static void appendPolygonRecord( std::vector<libShape::BYTE> &record, const libShape::CNT_POLYGON &rings, const libShape::S_BOUNDING_BOX &box) {
+
+	int numParts = (int) rings.size();
+	int numPoints = 0;
+	std::vector<int> partStarts;
+	for( size_t nRing = 0; rings.size() > nRing; ++ nRing) {
+		partStarts.push_back( numPoints);
+		numPoints += (int) rings[nRing].size();
+	}
+
+	record.resize( 40 + (4 * numParts) + (16 * numPoints));
+	libShape::BYTE *pRecord = &record[0];
+	memcpy( pRecord, &box, 32);
+	memcpy( pRecord + 32, &numParts, 4);
+	memcpy( pRecord + 36, &numPoints, 4);
+	memcpy( pRecord + 40, &partStarts[0], 4 * numParts);
+	libShape::BYTE *pPoints = pRecord + 40 + (4 * numParts);
+	for( size_t nRing = 0; rings.size() > nRing; ++ nRing) {
+		for( size_t nPoint = 0; rings[nRing].size() > nPoint; ++ nPoint) {
+			memcpy( pPoints, &rings[nRing][nPoint].x, 8);
+			memcpy( pPoints + 8, &rings[nRing][nPoint].y, 8);
+			pPoints += 16;
+		}
+	}
+
+}
+
+///////////
+// CHECK //
+///////////
+
+//
+// Report a query run
+//
+// The allocations counted since the last report are charged to the query
+//
+
+static void report( const char *strQuery, const bool bCorrect) {
+
+	unsigned long numAllocs = g_numAllocs;
+	g_numAllocs = 0;
+	printf( "%-44s %8lu allocations%s\n", strQuery, numAllocs, bCorrect ? "" : " - wrong answers");
+	if( (0 != numAllocs) || !bCorrect) {
+		++ g_numFailures;
+	}
+
+}
+
+int main() {
+
+	int nRetCode = EXIT_FAILURE;
+
+	// Wrap it all
+	try {
+
+		// Build the polygon records, each with a hole in its middle third, and decode them
+		libShape::CNT_SHAPES shapes;
+		std::vector<libShape::S_BOUNDING_BOX> boxes;
+		std::vector< std::vector<libShape::BYTE> > records;
+		std::vector<libShape::POLYGON> outerRings;
+		for( int nRow = 0; GRID_SIZE > nRow; ++ nRow) {
+			for( int nColumn = 0; GRID_SIZE > nColumn; ++ nColumn) {
+				double x = nColumn * CELL_SIZE;
+				double y = nRow * CELL_SIZE;
+				libShape::CNT_POLYGON rings;
+				rings.push_back( makeRing( x, y, CELL_SIZE * 0.9, false));
+				rings.push_back( makeRing( x + (CELL_SIZE * 0.3), y + (CELL_SIZE * 0.3), CELL_SIZE * 0.3, true));
+				libShape::S_BOUNDING_BOX box = { x, y, x + (CELL_SIZE * 0.9), y + (CELL_SIZE * 0.9) };
+				boxes.push_back( box);
+				records.push_back( std::vector<libShape::BYTE>());
+				appendPolygonRecord( records.back(), rings, box);
+				int recordNum = (int) shapes.size() + 1;
+				shapes.push_back( new libShape::ShapePolygon( recordNum, &records.back()[0], records.back().size()));
+				outerRings.push_back( rings[0]);
+			}
+		}
+
+		// And the structures queried
+		libShape::FlatLayer layer( shapes);
+		libShape::ShapeRTree shapeTree( shapes);
+		libShape::ShapeRTree layerTree( layer);
+		libShape::ShapeRTree boxTree( &boxes[0], boxes.size());
+		std::vector<libShape::PreparedPolygon *> prepared;
+		std::vector<libShape::PreparedPolygon *> preparedFlat;
+		std::vector<libShape::PolygonView> polygonViews;
+		for( size_t nShape = 0; shapes.size() > nShape; ++ nShape) {
+			prepared.push_back( new libShape::PreparedPolygon( * ((libShape::ShapePolygon *) shapes[nShape])));
+			preparedFlat.push_back( new libShape::PreparedPolygon( layer.getShape( nShape)));
+			polygonViews.push_back( libShape::PolygonView( (int) nShape + 1, &records[nShape][0], records[nShape].size()));
+		}
+		double pointXY[2] = { 5.0, 5.0 };
+		libShape::PointView pointView( 1, (const libShape::BYTE *) pointXY, sizeof( pointXY));
+
+		// The query points - a lattice across the grid and a margin around it, offset so no
+		// point lies on an edge, with the shape each should fall in (or -1) worked out from the layout
+		std::vector<double> queryX, queryY;
+		std::vector<long> expected;
+		double step = CELL_SIZE / 7.0;
+		double start = 0.0137 - CELL_SIZE;
+		for( double y = start; ((GRID_SIZE + 1) * CELL_SIZE) > y; y += step) {
+			for( double x = start; ((GRID_SIZE + 1) * CELL_SIZE) > x; x += step) {
+				long nShape = -1;
+				if( (0.0 <= x) && (0.0 <= y)) {
+					long nColumn = (long) (x / CELL_SIZE);
+					long nRow = (long) (y / CELL_SIZE);
+					double cellX = x - (nColumn * CELL_SIZE);
+					double cellY = y - (nRow * CELL_SIZE);
+					bool bInCell = (GRID_SIZE > nColumn) && (GRID_SIZE > nRow) &&
+						(0.0 < cellX) && ((CELL_SIZE * 0.9) > cellX) && (0.0 < cellY) && ((CELL_SIZE * 0.9) > cellY);
+					bool bInHole = ((CELL_SIZE * 0.3) <= cellX) && ((CELL_SIZE * 0.6) >= cellX) &&
+						((CELL_SIZE * 0.3) <= cellY) && ((CELL_SIZE * 0.6) >= cellY);
+					if( bInCell && !bInHole) {
+						nShape = (nRow * GRID_SIZE) + nColumn;
+					}
+				}
+				queryX.push_back( x);
+				queryY.push_back( y);
+				expected.push_back( nShape);
+			}
+		}
+		size_t numQueries = queryX.size();
+
+		// A jagged ring for the instruction set checks - odd sized so every kernel has a tail, with
+		// horizontal edges, NaN coordinates, and query rows through its vertices.  It is held both
+		// in its own arrays and interleaved four values to a point, to take the gather path.
+		static const size_t RING_POINTS = 39;
+		std::vector<double> ringX, ringY, ringXYMZ;
+		for( size_t nPoint = 0; RING_POINTS > nPoint; ++ nPoint) {
+			double angle = -6.283185307179586 * nPoint / (RING_POINTS - 1);
+			double radius = (0 == (nPoint % 3)) ? 40.0 : 70.0;
+			double x = 100.0 + (radius * cos( angle));
+			double y = floor( 100.0 + (radius * sin( angle)));
+			if( (0 < nPoint) && (0 == (nPoint % 7))) y = ringY.back();
+			if( 10 == nPoint) x = NAN;
+			if( 20 == nPoint) y = NAN;
+			if( RING_POINTS - 1 == nPoint) {
+				x = ringX[0];
+				y = ringY[0];
+			}
+			ringX.push_back( x);
+			ringY.push_back( y);
+			double values[4] = { x, y, 0.0, 0.0 };
+			ringXYMZ.insert( ringXYMZ.end(), values, values + 4);
+		}
+
+		// Room for every result, so appending never grows them
+		std::vector<size_t> indexResults;
+		indexResults.reserve( shapes.size());
+		libShape::CNT_SHAPES shapeResults;
+		shapeResults.reserve( shapes.size());
+		std::vector<int> recordNums( numQueries);
+		printf( "\n%lu shapes, %lu query points\n\n", (unsigned long) shapes.size(), (unsigned long) numQueries);
+
+		// From here on nothing may allocate
+		g_numAllocs = 0;
+		g_bCountAllocs = true;
+
+		// PreparedPolygon::containsPoint - from decoded and flat shapes
+		bool bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			long nShape = expected[nQuery];
+			size_t nCheck = (0 > nShape) ? (nQuery % shapes.size()) : (size_t) nShape;
+			bool bExpected = (0 <= nShape);
+			bCorrect &= (bExpected == prepared[nCheck]->containsPoint( queryX[nQuery], queryY[nQuery]));
+			bCorrect &= (bExpected == preparedFlat[nCheck]->containsPoint( queryX[nQuery], queryY[nQuery]));
+		}
+		report( "PreparedPolygon::containsPoint", bCorrect);
+
+		// FlatShape::containsPoint and PolygonView::containsPoint
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			long nShape = expected[nQuery];
+			size_t nCheck = (0 > nShape) ? (nQuery % shapes.size()) : (size_t) nShape;
+			bCorrect &= ((0 <= nShape) == layer.getShape( nCheck).containsPoint( queryX[nQuery], queryY[nQuery]));
+		}
+		report( "FlatShape::containsPoint", bCorrect);
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			long nShape = expected[nQuery];
+			size_t nCheck = (0 > nShape) ? (nQuery % shapes.size()) : (size_t) nShape;
+			bCorrect &= ((0 <= nShape) == polygonViews[nCheck].containsPoint( queryX[nQuery], queryY[nQuery]));
+		}
+		report( "PolygonView::containsPoint", bCorrect);
+		bCorrect = pointView.containsPoint( 5.0, 5.0) && !pointView.containsPoint( 5.0, 6.0);
+		report( "PointView::containsPoint", bCorrect);
+
+		// ShapeRTree::queryPoint and queryBox - each point must find the box of its shape
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			indexResults.clear();
+			size_t numFound = layerTree.queryPoint( queryX[nQuery], queryY[nQuery], indexResults);
+			if( 0 <= expected[nQuery]) {
+				bCorrect &= (1 == numFound) && ((size_t) expected[nQuery] == indexResults[0]);
+			}
+			shapeResults.clear();
+			shapeTree.queryPoint( queryX[nQuery], queryY[nQuery], shapeResults);
+			bCorrect &= (numFound == shapeResults.size());
+			indexResults.clear();
+			libShape::S_BOUNDING_BOX box = { queryX[nQuery], queryY[nQuery], queryX[nQuery] + CELL_SIZE, queryY[nQuery] + CELL_SIZE };
+			bCorrect &= (0 < boxTree.queryBox( box, indexResults)) || (0 > expected[nQuery]);
+		}
+		report( "ShapeRTree::queryPoint / queryBox", bCorrect);
+
+		// ShapeRTree::queryNearest - points within a shape are at no distance from its box
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			size_t nIndex = 0;
+			double distance = -1.0;
+			bCorrect &= boxTree.queryNearest( queryX[nQuery], queryY[nQuery], nIndex, &distance);
+			if( 0 <= expected[nQuery]) {
+				bCorrect &= ((size_t) expected[nQuery] == nIndex) && (0.0 == distance);
+			}
+		}
+		report( "ShapeRTree::queryNearest", bCorrect);
+
+		// ShapeRTree::findContaining and getRecordNumber - over decoded shapes and the flat layer
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			long nFound = shapeTree.findContaining( queryX[nQuery], queryY[nQuery]);
+			bCorrect &= (expected[nQuery] == nFound);
+			bCorrect &= (nFound == layerTree.findContaining( queryX[nQuery], queryY[nQuery]));
+			if( 0 <= nFound) {
+				bCorrect &= ((int) nFound + 1 == layerTree.getRecordNumber( nFound));
+			}
+		}
+		report( "ShapeRTree::findContaining", bCorrect);
+
+		// classifyPoints - on the calling thread, as starting threads allocates
+		libShape::classifyPoints( layerTree, &queryX[0], &queryY[0], numQueries, &recordNums[0], 1);
+		bCorrect = true;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			bCorrect &= (((0 > expected[nQuery]) ? -1 : (int) expected[nQuery] + 1) == recordNums[nQuery]);
+		}
+		report( "classifyPoints", bCorrect);
+
+		// getWindingNumber, onLeftSide and onRightSide - against the outer ring alone
+		// onRightSide works from angles, and only agrees with onLeftSide for some edge
+		// directions, so only its allocations are checked
+		bCorrect = true;
+		size_t numOnRight = 0;
+		for( size_t nQuery = 0; numQueries > nQuery; ++ nQuery) {
+			long nShape = expected[nQuery];
+			if( 0 > nShape) continue;
+			const libShape::POLYGON &ring = outerRings[nShape];
+			libShape::S_POINT point = { queryX[nQuery], queryY[nQuery], 0.0, 0.0 };
+			bCorrect &= (-1 == libShape::getWindingNumber( ring, point));
+			bCorrect &= (-1 == libShape::getWindingNumber( &ring[0].x, &ring[0].y, ring.size(), point.x, point.y, 4));
+			bCorrect &= (0 > libShape::onLeftSide( ring[0], ring[1], point));
+			numOnRight += libShape::onRightSide( ring[0], ring[1], point) ? 1 : 0;
+		}
+		report( "getWindingNumber / onLeftSide / onRightSide", bCorrect);
+
+		// countCrossings - every instruction set the CPU has must agree with summing the edges
+		bCorrect = true;
+		libShape::E_SIMD_LEVEL initialLevel = libShape::getSimdLevel();
+		libShape::E_SIMD_LEVEL levels[3] = { libShape::SIMD_NONE, libShape::SIMD_SSE2, libShape::SIMD_AVX2 };
+		for( double y = 25.0; 175.0 > y; y += 0.5) {
+			for( double x = 25.0; 175.0 > x; x += 1.25) {
+				int expectedCrossings = 0;
+				for( size_t nPoint = 0; RING_POINTS - 1 > nPoint; ++ nPoint) {
+					expectedCrossings += libShape::getEdgeCrossing( ringX[nPoint], ringY[nPoint], ringX[nPoint + 1], ringY[nPoint + 1], x, y);
+				}
+				for( int nLevel = 0; 3 > nLevel; ++ nLevel) {
+					libShape::setSimdLevel( levels[nLevel]);
+					bCorrect &= (expectedCrossings == libShape::countCrossings( &ringX[0], &ringY[0], RING_POINTS - 1, x, y));
+					bCorrect &= (expectedCrossings == libShape::countCrossings( &ringXYMZ[0], &ringXYMZ[1], RING_POINTS - 1, x, y, 4));
+				}
+			}
+		}
+		libShape::setSimdLevel( initialLevel);
+		report( "countCrossings at each instruction set", bCorrect);
+
+		// And done
+		g_bCountAllocs = false;
+		if( 0 != g_numFailures) {
+			fprintf( stderr, "\nError - %lu queries allocated memory or gave wrong answers!\n\n", g_numFailures);
+		}
+		else {
+			printf( "\nNo allocations during queries\n\n");
+			nRetCode = EXIT_SUCCESS;
+		}
+
+		// Clean up
+		for( size_t nShape = 0; shapes.size() > nShape; ++ nShape) {
+			delete prepared[nShape];
+			delete preparedFlat[nShape];
+			delete shapes[nShape];
+		}
+
+	}
+	catch( libShape::ShapeException *e) {
+		g_bCountAllocs = false;
+		fprintf( stderr, "Caught a shape exception: %s\n", e->excpMsg.c_str());
+		nRetCode = EXIT_FAILURE;
+		delete e;
+	}
+
+	return( nRetCode);
+
+}